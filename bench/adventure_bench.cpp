@@ -0,0 +1,307 @@
+// Microbenchmarks for the engine hot paths. Prints one JSON document with per-operation timing
+// percentiles, so runs before and after an engine change can be compared.
+//
+//   adventure_bench [--samples N] [--filter substring]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "context/game_context.h"
+#include "engine/engine.h"
+#include "levels/choice_level.h"
+#include "levels/input_level.h"
+#include "levels/terminal_level.h"
+#include "levels/terminal_level_factory.h"
+#include "parser/tag_parser.h"
+#include "ui/renderer.h"
+#include "ui/theme.h"
+#include "validation/memory_footprint.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kMinSampleTime = std::chrono::milliseconds(2);
+
+struct BenchOptions {
+  int samples = 25;
+  std::string filter;
+};
+
+struct BenchResult {
+  std::string name;
+  std::uint64_t iterations_per_sample = 0;
+  std::vector<double> ns_per_op;  // one entry per sample, sorted
+  double items_per_op = 1.0;      // e.g. levels parsed or transitions taken per call
+  double bytes_per_op = 0.0;
+};
+
+class DiscardBuffer : public std::streambuf {
+ protected:
+  int overflow(int ch) override { return ch; }
+  std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+volatile std::size_t g_sink = 0;
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+  const double position = fraction * static_cast<double>(sorted.size() - 1);
+  const std::size_t lower = static_cast<std::size_t>(position);
+  const std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+  return sorted[lower] + (sorted[upper] - sorted[lower]) * (position - static_cast<double>(lower));
+}
+
+// Picks an iteration count that makes one sample last at least kMinSampleTime, then times
+// `samples` such batches.
+BenchResult run_benchmark(const BenchOptions& options, std::string name, double items_per_op,
+                          double bytes_per_op, const std::function<void()>& op) {
+  BenchResult result;
+  result.name = std::move(name);
+  result.items_per_op = items_per_op;
+  result.bytes_per_op = bytes_per_op;
+
+  std::uint64_t iterations = 1;
+  while (true) {
+    const Clock::time_point begin = Clock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      op();
+    }
+    if (Clock::now() - begin >= kMinSampleTime || iterations >= (1ull << 30)) {
+      break;
+    }
+    iterations *= 2;
+  }
+  result.iterations_per_sample = iterations;
+
+  for (int sample = 0; sample < options.samples; ++sample) {
+    const Clock::time_point begin = Clock::now();
+    for (std::uint64_t i = 0; i < iterations; ++i) {
+      op();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(Clock::now() - begin).count();
+    result.ns_per_op.push_back(ns / static_cast<double>(iterations));
+  }
+  std::sort(result.ns_per_op.begin(), result.ns_per_op.end());
+  return result;
+}
+
+std::string sample_level_text(std::size_t options, std::size_t content_lines) {
+  std::ostringstream text;
+  text << "[HEADER]\nid: bench\ntitle: Benchmark Hall\n\n[CONTENT]\n";
+  for (std::size_t i = 0; i < content_lines; ++i) {
+    text << "Line " << i << " of a long description of a dusty hall full of doors.\n";
+  }
+  text << "\n[OPTIONS]\n";
+  for (std::size_t i = 0; i < options; ++i) {
+    text << "door_" << i << " | Open door " << i << " -> ./rooms/room_" << i << ".level\n";
+  }
+  text << "\n[DIRECTIVES]\ninput_mode: choice\n\n[MEMORY]\non_enter add_flag=visited_hall\n"
+       << "on_enter set_value=zone:hall\n\n[OPTION_CONDITIONS]\n";
+  for (std::size_t i = 0; i < options; ++i) {
+    text << "option=door_" << i << " requires_flag=key_" << i << "\n";
+    text << "option=door_" << i << " forbids_flag=door_" << i << "_jammed\n";
+    text << "option=door_" << i << " requires_value=zone:hall\n";
+  }
+  text << "\n[OPTION_EFFECTS]\n";
+  for (std::size_t i = 0; i < options; ++i) {
+    text << "option=door_" << i << " add_flag=opened_" << i << "\n";
+  }
+  return text.str();
+}
+
+std::string input_level_text(std::size_t rules) {
+  std::ostringstream text;
+  text << "[HEADER]\ntitle: Riddle Door\n\n[CONTENT]\nA stone face waits.\n\n[DIRECTIVES]\n"
+       << "input_mode: input\ninput_match: contains\ninput_case_sensitive: false\n\n"
+       << "[INPUT_RULES]\n";
+  for (std::size_t i = 0; i < rules; ++i) {
+    text << "rule_" << i << " | magic word number " << i << " -> ./next.level\n";
+  }
+  return text.str();
+}
+
+adventure::parser::ParsedLevelData parse_text(const std::string& text) {
+  std::istringstream input(text);
+  return adventure::parser::TagParser().parse(input);
+}
+
+// A linear chain of choice levels ending in a victory, for whole-engine runs.
+std::filesystem::path write_chain_game(std::size_t length) {
+  const std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "cli_adventure_bench_chain";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root);
+  for (std::size_t i = 0; i < length; ++i) {
+    std::ofstream out(root / ("level_" + std::to_string(i) + ".level"));
+    out << "[HEADER]\ntitle: Room " << i << "\n\n[CONTENT]\nA quiet room.\n\n[OPTIONS]\n"
+        << "next | Continue -> ./"
+        << (i + 1 == length ? std::string("win") : "level_" + std::to_string(i + 1))
+        << ".level\n\n[OPTION_EFFECTS]\noption=next set_value=room:" << i << "\n";
+  }
+  std::ofstream(root / "win.level") << "[DIRECTIVES]\ninput_mode: endgame\nresult: victory\n";
+  return root;
+}
+
+void print_json(const std::vector<BenchResult>& results) {
+  std::cout << "{\n  \"benchmarks\": [";
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const BenchResult& result = results[i];
+    const double median = percentile(result.ns_per_op, 0.5);
+    std::cout << (i == 0 ? "\n" : ",\n") << std::fixed << std::setprecision(1);
+    std::cout << "    {\"name\": \"" << result.name << "\", \"samples\": "
+              << result.ns_per_op.size() << ", \"iterations_per_sample\": "
+              << result.iterations_per_sample << ",\n     \"ns_per_op\": {\"min\": "
+              << result.ns_per_op.front() << ", \"median\": " << median
+              << ", \"p90\": " << percentile(result.ns_per_op, 0.9)
+              << ", \"p99\": " << percentile(result.ns_per_op, 0.99)
+              << ", \"max\": " << result.ns_per_op.back() << "},\n     \"items_per_second\": "
+              << result.items_per_op * 1e9 / median;
+    if (result.bytes_per_op > 0.0) {
+      std::cout << ", \"mb_per_second\": " << result.bytes_per_op * 1e3 / median;
+    }
+    std::cout << "}";
+  }
+  std::cout << "\n  ]\n}\n";
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  BenchOptions options;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const std::string flag = argv[i];
+    if (flag == "--samples") {
+      options.samples = std::max(1, std::atoi(argv[i + 1]));
+    } else if (flag == "--filter") {
+      options.filter = argv[i + 1];
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--samples N] [--filter substring]\n";
+      return 2;
+    }
+  }
+
+  DiscardBuffer discard_buffer;
+  std::ostream discard(&discard_buffer);
+  const adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  const adventure::parser::TagParser parser;
+  std::vector<BenchResult> results;
+  const auto bench = [&](std::string name, double items, double bytes,
+                         const std::function<void()>& op) {
+    if (name.find(options.filter) != std::string::npos) {
+      results.push_back(run_benchmark(options, std::move(name), items, bytes, op));
+    }
+  };
+
+  const std::string level_text = sample_level_text(16, 24);
+  bench("tag_parser_parse", 1.0, static_cast<double>(level_text.size()), [&]() {
+    std::istringstream input(level_text);
+    g_sink = g_sink + parser.parse(input).options.size();
+  });
+
+  // The engine hands each fresh parse to the factory by move; the copy variant shows what a
+  // deep copy of the same ParsedLevelData would add (bytes = the copied strings and containers).
+  const adventure::parser::ParsedLevelData level_data = parse_text(level_text);
+  const adventure::levels::TerminalLevelFactory factory(renderer);
+  bench("level_parse_create_moved", 1.0, static_cast<double>(level_text.size()), [&]() {
+    std::istringstream input(level_text);
+    g_sink = g_sink + (factory.create(parser.parse(input)) != nullptr ? 1 : 0);
+  });
+  const double copied_bytes =
+      static_cast<double>(adventure::validation::measure_parsed_level(level_data).total());
+  bench("level_factory_create_copy", 1.0, copied_bytes, [&]() {
+    g_sink = g_sink + (factory.create(level_data) != nullptr ? 1 : 0);
+  });
+
+  // Condition evaluation: every option carries three conditions and half of them pass.
+  adventure::levels::ChoiceLevel choice_level(level_data, renderer);
+  adventure::context::GameContext choice_context;
+  for (int i = 0; i < 16; i += 2) {
+    choice_context.set_memory_flag("key_" + std::to_string(i));
+  }
+  bench("choice_level_conditions", 1.0, 0.0, [&]() {
+    std::istringstream in("1\n");
+    choice_level.execute(in, discard, choice_context);
+    choice_context.clear_next_level_request();
+  });
+
+  // Rule matching: the typed answer matches only the last of 32 `contains` rules.
+  adventure::levels::InputLevel input_level(parse_text(input_level_text(32)), renderer);
+  adventure::context::GameContext input_context;
+  bench("input_level_rule_match", 1.0, 0.0, [&]() {
+    std::istringstream in("I say MAGIC WORD NUMBER 31 loudly\n");
+    input_level.execute(in, discard, input_context);
+    input_context.clear_next_level_request();
+  });
+
+  const std::vector<std::string> content(24, "A long description of a dusty hall full of doors.");
+  bench("renderer_render_scene", 1.0, 0.0, [&]() {
+    renderer.render_scene(discard, "Benchmark Hall", content, "", "");
+  });
+
+  constexpr std::size_t kChainLength = 50;
+  const std::filesystem::path chain = write_chain_game(kChainLength);
+  std::string script;
+  for (std::size_t i = 0; i < kChainLength; ++i) {
+    script += "1\n";
+  }
+  script += "\n";
+  bench("engine_run_transition", kChainLength + 1.0, 0.0, [&]() {
+    adventure::context::GameContext context;
+    context.set_current_level_path((chain / "level_0.level").string());
+    adventure::engine::Engine engine{adventure::ui::Renderer(adventure::ui::Theme{})};
+    std::istringstream in(script);
+    engine.run(in, discard, context);
+    g_sink = g_sink + (context.is_victory() ? 1 : 0);
+  });
+
+  // The same chain driven directly, once through heap-allocated ILevel objects (virtual calls)
+  // and once through inline TerminalLevel variants, to compare the two representations.
+  std::vector<std::unique_ptr<adventure::levels::ILevel>> boxed_levels;
+  std::vector<adventure::levels::TerminalLevel> inline_levels;
+  std::vector<std::string> chain_paths;
+  inline_levels.reserve(kChainLength);
+  for (std::size_t i = 0; i < kChainLength; ++i) {
+    const std::filesystem::path path = chain / ("level_" + std::to_string(i) + ".level");
+    chain_paths.push_back(path.string());
+    boxed_levels.push_back(factory.create(parser.parse_file(path)));
+    inline_levels.push_back(factory.create_inline(parser.parse_file(path)));
+  }
+  const auto run_chain = [&](const auto& visit_level) {
+    adventure::context::GameContext context;
+    std::istringstream in(script);
+    for (std::size_t i = 0; i < kChainLength; ++i) {
+      context.set_current_level_path(chain_paths[i]);
+      visit_level(i, in, context);
+      context.clear_next_level_request();
+    }
+    g_sink = g_sink + context.memory_values().size();
+  };
+  bench("level_dispatch_virtual", static_cast<double>(kChainLength), 0.0, [&]() {
+    run_chain([&](std::size_t i, std::istream& in, adventure::context::GameContext& context) {
+      boxed_levels[i]->render(discard, context);
+      boxed_levels[i]->execute(in, discard, context);
+    });
+  });
+  bench("level_dispatch_variant", static_cast<double>(kChainLength), 0.0, [&]() {
+    run_chain([&](std::size_t i, std::istream& in, adventure::context::GameContext& context) {
+      adventure::levels::render_level(inline_levels[i], discard, context);
+      adventure::levels::execute_level(inline_levels[i], in, discard, context);
+    });
+  });
+  std::filesystem::remove_all(chain);
+
+  print_json(results);
+  return 0;
+}
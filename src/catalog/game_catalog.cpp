@@ -0,0 +1,302 @@
+#include "catalog/game_catalog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <system_error>
+#include <unordered_map>
+
+#include "parser/tag_parser.h"
+
+namespace adventure::catalog {
+namespace {
+
+constexpr const char* kIndexHeader = "cli_adventure_catalog 1";
+
+// Directory timestamps can be too coarse to see two changes in quick succession. An mtime this
+// recent is recorded as unstable so the next refresh checks again instead of trusting it.
+constexpr std::chrono::seconds kStableAge{2};
+constexpr std::int64_t kUnstableMtime = -1;
+constexpr std::int64_t kMissingMtime = -2;
+
+std::int64_t current_mtime(const std::filesystem::path& path) {
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(path, error);
+  return error ? kMissingMtime : static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+std::int64_t recorded_mtime(const std::filesystem::path& path) {
+  std::error_code error;
+  const auto time = std::filesystem::last_write_time(path, error);
+  if (error) {
+    return kMissingMtime;
+  }
+  if (std::filesystem::file_time_type::clock::now() - time < kStableAge) {
+    return kUnstableMtime;
+  }
+  return static_cast<std::int64_t>(time.time_since_epoch().count());
+}
+
+bool same_mtime(std::int64_t recorded, std::int64_t current) {
+  return recorded == current && recorded != kUnstableMtime;
+}
+
+std::string single_line(std::string text) {
+  std::replace(text.begin(), text.end(), '\t', ' ');
+  std::replace(text.begin(), text.end(), '\n', ' ');
+  return text;
+}
+
+std::vector<std::string> split_tabs(const std::string& line) {
+  std::vector<std::string> fields;
+  std::size_t start = 0;
+  while (true) {
+    const std::size_t tab = line.find('\t', start);
+    fields.push_back(line.substr(start, tab - start));
+    if (tab == std::string::npos) {
+      return fields;
+    }
+    start = tab + 1;
+  }
+}
+
+}  // namespace
+
+std::filesystem::path default_catalog_index_path(const std::filesystem::path& games_root) {
+  std::filesystem::path cache_root;
+  if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg != nullptr && *xdg != '\0') {
+    cache_root = xdg;
+  } else if (const char* home = std::getenv("HOME"); home != nullptr && *home != '\0') {
+    cache_root = std::filesystem::path(home) / ".cache";
+  } else {
+    return {};
+  }
+
+  std::error_code error;
+  std::filesystem::path absolute = std::filesystem::absolute(games_root, error);
+  if (error) {
+    absolute = games_root;
+  }
+  std::uint64_t hash = 0xcbf29ce484222325ull;  // FNV-1a
+  for (const char ch : absolute.lexically_normal().string()) {
+    hash ^= static_cast<unsigned char>(ch);
+    hash *= 0x100000001b3ull;
+  }
+  std::ostringstream name;
+  name << "catalog-" << std::hex << hash << ".index";
+  return cache_root / "cli_adventure" / name.str();
+}
+
+GameCatalog::GameCatalog(std::filesystem::path games_root, std::filesystem::path index_path)
+    : games_root_(std::move(games_root)), index_path_(std::move(index_path)) {
+  load_index();
+  publish();
+}
+
+const std::vector<CatalogEntry>& GameCatalog::games() const { return games_; }
+
+bool GameCatalog::refresh() {
+  bool changed = false;
+  const std::int64_t previous_root_mtime = root_mtime_;
+  const std::int64_t root_mtime = current_mtime(games_root_);
+
+  if (!same_mtime(root_mtime_, root_mtime)) {
+    // The set of game folders may have changed: list the root, keep fresh records by name.
+    std::unordered_map<std::string, GameRecord*> known;
+    for (GameRecord& record : records_) {
+      known.emplace(record.entry.root.filename().string(), &record);
+    }
+
+    std::vector<std::filesystem::path> roots;
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(games_root_, error), end; !error && it != end;
+         it.increment(error)) {
+      if (it->is_directory(error)) {
+        roots.push_back(it->path().lexically_normal());
+      }
+    }
+    std::sort(roots.begin(), roots.end(),
+              [](const std::filesystem::path& left, const std::filesystem::path& right) {
+                return left.filename().string() < right.filename().string();
+              });
+
+    std::vector<GameRecord> records;
+    records.reserve(roots.size());
+    for (const auto& root : roots) {
+      const auto it = known.find(root.filename().string());
+      if (it != known.end() && is_fresh(*it->second)) {
+        records.push_back(std::move(*it->second));
+        continue;
+      }
+      GameRecord record;
+      if (scan_game(root, &record)) {
+        records.push_back(std::move(record));
+      }
+      changed = true;
+    }
+    changed = changed || records.size() != records_.size();
+    records_ = std::move(records);
+    root_mtime_ = recorded_mtime(games_root_);
+  } else {
+    for (std::size_t i = 0; i < records_.size();) {
+      if (is_fresh(records_[i])) {
+        ++i;
+        continue;
+      }
+      changed = true;
+      if (scan_game(records_[i].entry.root, &records_[i])) {
+        ++i;
+      } else {
+        records_.erase(records_.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+    }
+  }
+
+  if (changed) {
+    publish();
+  }
+  if (changed || root_mtime_ != previous_root_mtime) {
+    save_index();
+  }
+  return changed;
+}
+
+bool GameCatalog::is_fresh(const GameRecord& record) const {
+  if (!same_mtime(record.start_mtime, current_mtime(record.entry.root / "start.level"))) {
+    return false;
+  }
+  for (const auto& [relative, mtime] : record.directories) {
+    if (!same_mtime(mtime, current_mtime(record.entry.root / relative))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool GameCatalog::scan_game(const std::filesystem::path& game_root, GameRecord* record) {
+  const std::filesystem::path start_file = game_root / "start.level";
+  std::error_code error;
+  if (!std::filesystem::is_regular_file(start_file, error)) {
+    return false;
+  }
+
+  GameRecord scanned;
+  scanned.entry.root = game_root;
+  scanned.entry.title = game_root.filename().string();
+  scanned.start_mtime = recorded_mtime(start_file);
+  try {
+    const adventure::parser::ParsedLevelData data =
+        adventure::parser::TagParser().parse_file(start_file);
+    const auto title_it = data.header.find("title");
+    if (title_it != data.header.end() && !title_it->second.empty()) {
+      scanned.entry.title = single_line(title_it->second);
+    }
+    const auto author_it = data.header.find("author");
+    if (author_it != data.header.end()) {
+      scanned.entry.author = single_line(author_it->second);
+    }
+  } catch (const std::exception&) {
+    // Still playable from the launcher's point of view; the validator reports the parse error.
+  }
+
+  scanned.directories.emplace_back(".", recorded_mtime(game_root));
+  for (std::filesystem::recursive_directory_iterator it(game_root, error), end;
+       !error && it != end; it.increment(error)) {
+    if (it->is_directory(error)) {
+      scanned.directories.emplace_back(
+          it->path().lexically_relative(game_root).generic_string(), recorded_mtime(it->path()));
+    } else if (it->is_regular_file(error) && it->path().extension() == ".level") {
+      ++scanned.entry.level_count;
+    }
+  }
+
+  *record = std::move(scanned);
+  return true;
+}
+
+void GameCatalog::publish() {
+  games_.clear();
+  games_.reserve(records_.size());
+  for (const GameRecord& record : records_) {
+    games_.push_back(record.entry);
+  }
+}
+
+void GameCatalog::load_index() {
+  if (index_path_.empty()) {
+    root_mtime_ = kUnstableMtime;
+    return;
+  }
+
+  std::ifstream in(index_path_);
+  std::string line;
+  root_mtime_ = kUnstableMtime;
+  if (!in.is_open() || !std::getline(in, line) || line != kIndexHeader) {
+    return;
+  }
+
+  std::vector<GameRecord> records;
+  std::int64_t root_mtime = kUnstableMtime;
+  try {
+    while (std::getline(in, line)) {
+      const std::vector<std::string> fields = split_tabs(line);
+      if (fields[0] == "R" && fields.size() == 2) {
+        root_mtime = std::stoll(fields[1]);
+      } else if (fields[0] == "G" && fields.size() == 6) {
+        GameRecord record;
+        record.entry.root = (games_root_ / fields[1]).lexically_normal();
+        record.start_mtime = std::stoll(fields[2]);
+        record.entry.level_count = std::stoull(fields[3]);
+        record.entry.title = fields[4];
+        record.entry.author = fields[5];
+        records.push_back(std::move(record));
+      } else if (fields[0] == "D" && fields.size() == 3 && !records.empty()) {
+        records.back().directories.emplace_back(fields[2], std::stoll(fields[1]));
+      } else {
+        return;
+      }
+    }
+  } catch (const std::exception&) {
+    return;  // a damaged index only costs one full scan
+  }
+
+  records_ = std::move(records);
+  root_mtime_ = root_mtime;
+}
+
+void GameCatalog::save_index() const {
+  if (index_path_.empty()) {
+    return;
+  }
+
+  std::error_code error;
+  std::filesystem::create_directories(index_path_.parent_path(), error);
+  const std::filesystem::path temp_path = index_path_.string() + ".tmp";
+  {
+    std::ofstream out(temp_path, std::ios::trunc);
+    if (!out.is_open()) {
+      return;
+    }
+    out << kIndexHeader << "\n";
+    out << "R\t" << root_mtime_ << "\n";
+    for (const GameRecord& record : records_) {
+      out << "G\t" << record.entry.root.filename().string() << "\t" << record.start_mtime << "\t"
+          << record.entry.level_count << "\t" << record.entry.title << "\t"
+          << record.entry.author << "\n";
+      for (const auto& [relative, mtime] : record.directories) {
+        out << "D\t" << mtime << "\t" << relative << "\n";
+      }
+    }
+    if (!out) {
+      return;
+    }
+  }
+  std::filesystem::rename(temp_path, index_path_, error);
+  if (error) {
+    std::filesystem::remove(temp_path, error);
+  }
+}
+
+}  // namespace adventure::catalog
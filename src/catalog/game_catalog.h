@@ -0,0 +1,62 @@
+#ifndef CLI_ADVENTURE_CATALOG_GAME_CATALOG_H_
+#define CLI_ADVENTURE_CATALOG_GAME_CATALOG_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace adventure::catalog {
+
+struct CatalogEntry {
+  std::filesystem::path root;
+  std::string title;   // start.level `title:`, or the folder name
+  std::string author;  // start.level `author:`, may be empty
+  std::size_t level_count = 0;
+};
+
+// `$XDG_CACHE_HOME/cli_adventure/` (or `~/.cache/...`), one index file per games root, so shared
+// or read-only game libraries are never written to. Empty when no cache directory is known.
+std::filesystem::path default_catalog_index_path(const std::filesystem::path& games_root);
+
+// Games found under a games root, persisted in an index file. A refresh only stats the
+// directories recorded for each game (plus its start.level); a game is rescanned when one of
+// those mtimes moved, and the games root is listed again only when its own mtime moved.
+class GameCatalog {
+ public:
+  // An empty `index_path` keeps the catalog in memory only.
+  GameCatalog(std::filesystem::path games_root, std::filesystem::path index_path);
+
+  // Brings the catalog up to date and rewrites the index if anything changed. Returns true when
+  // the list of games changed or any game was rescanned.
+  bool refresh();
+
+  const std::vector<CatalogEntry>& games() const;
+
+ private:
+  struct GameRecord {
+    CatalogEntry entry;
+    std::int64_t start_mtime = 0;
+    // Every directory of the game (relative, "." for the game root) with its mtime. Files added
+    // or removed anywhere in the tree move one of these.
+    std::vector<std::pair<std::string, std::int64_t>> directories;
+  };
+
+  void load_index();
+  void save_index() const;
+  bool is_fresh(const GameRecord& record) const;
+  static bool scan_game(const std::filesystem::path& game_root, GameRecord* record);
+  void publish();
+
+  std::filesystem::path games_root_;
+  std::filesystem::path index_path_;
+  std::int64_t root_mtime_ = 0;
+  std::vector<GameRecord> records_;  // sorted by folder name
+  std::vector<CatalogEntry> games_;
+};
+
+}  // namespace adventure::catalog
+
+#endif  // CLI_ADVENTURE_CATALOG_GAME_CATALOG_H_
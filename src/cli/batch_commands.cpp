@@ -0,0 +1,241 @@
+#include "cli/batch_commands.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "context/game_context.h"
+#include "engine/engine.h"
+#include "levels/terminal_level_factory.h"
+#include "parser/tag_parser.h"
+#include "ui/renderer.h"
+#include "ui/theme.h"
+#include "validation/game_validator.h"
+#include "validation/memory_footprint.h"
+#include "validation/state_explorer.h"
+
+namespace adventure::cli {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kBenchRounds = 20;
+constexpr std::size_t kFootprintTopLevels = 10;
+
+std::string json_string(const std::string& text) {
+  std::string quoted = "\"";
+  for (const char ch : text) {
+    switch (ch) {
+      case '"':
+        quoted += "\\\"";
+        break;
+      case '\\':
+        quoted += "\\\\";
+        break;
+      case '\n':
+        quoted += "\\n";
+        break;
+      case '\t':
+        quoted += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(ch) < 0x20) {
+          char escaped[8];
+          std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(ch));
+          quoted += escaped;
+        } else {
+          quoted += ch;
+        }
+    }
+  }
+  return quoted + "\"";
+}
+
+// Swallows rendered frames so the benchmark measures composition, not the terminal.
+class DiscardBuffer : public std::streambuf {
+ protected:
+  int overflow(int ch) override { return ch; }
+  std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+std::vector<std::filesystem::path> find_levels(const std::filesystem::path& game_root) {
+  std::vector<std::filesystem::path> levels;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(game_root)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".level") {
+      levels.push_back(entry.path().lexically_normal());
+    }
+  }
+  std::sort(levels.begin(), levels.end());
+  return levels;
+}
+
+double elapsed_us(Clock::time_point begin) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+}
+
+}  // namespace
+
+int run_validate_command(const std::filesystem::path& game_root, std::ostream& out) {
+  const adventure::validation::ValidationReport report =
+      adventure::validation::validate_game(game_root);
+  const adventure::validation::ExplorationReport exploration =
+      adventure::validation::explore_game(game_root);
+
+  out << "{\n";
+  out << "  \"game\": " << json_string(game_root.string()) << ",\n";
+  out << "  \"checked_files\": " << report.checked_files << ",\n";
+  out << "  \"rechecked_files\": " << report.rechecked_files << ",\n";
+  out << "  \"issues\": [";
+  for (std::size_t i = 0; i < report.issues.size(); ++i) {
+    out << (i == 0 ? "\n" : ",\n") << "    {\"file\": "
+        << json_string(report.issues[i].file.string())
+        << ", \"message\": " << json_string(report.issues[i].message) << "}";
+  }
+  out << (report.issues.empty() ? "],\n" : "\n  ],\n");
+  out << "  \"exploration\": {\"victory_reachable\": "
+      << (exploration.victory_reachable ? "true" : "false")
+      << ", \"truncated\": " << (exploration.truncated ? "true" : "false")
+      << ", \"states\": " << exploration.states_explored << ", \"shortest_path\": [";
+  for (std::size_t i = 0; i < exploration.winning_path.size(); ++i) {
+    const auto& step = exploration.winning_path[i];
+    out << (i == 0 ? "" : ", ") << "{\"level\": "
+        << json_string(step.level.lexically_relative(game_root).generic_string())
+        << ", \"choice\": " << json_string(step.choice) << "}";
+  }
+  out << "]}\n}\n";
+
+  return report.issues.empty() && exploration.victory_reachable ? kExitOk : kExitFailed;
+}
+
+int run_play_command(const std::filesystem::path& game_root, std::istream& script,
+                     std::ostream& out) {
+  adventure::context::GameContext context;
+  context.set_current_directory(game_root.string());
+  context.set_current_level_path((game_root / "start.level").lexically_normal().string());
+
+  adventure::engine::Engine engine{adventure::ui::Renderer(adventure::ui::Theme{})};
+  engine.run(script, out, context);
+  out.flush();
+  return context.is_victory() ? kExitOk : kExitFailed;
+}
+
+int run_bench_command(const std::filesystem::path& game_root, std::ostream& out) {
+  const std::vector<std::filesystem::path> levels = find_levels(game_root);
+  if (levels.empty()) {
+    out << "No .level files found in " << game_root.string() << "\n";
+    return kExitUsage;
+  }
+
+  DiscardBuffer discard_buffer;
+  std::ostream discard(&discard_buffer);
+  const adventure::parser::TagParser parser;
+  double load_us = 0.0;
+  double parse_us = 0.0;
+  double build_us = 0.0;
+  double render_us = 0.0;
+  double rerender_us = 0.0;
+
+  for (int round = 0; round < kBenchRounds; ++round) {
+    // A fresh renderer per round so the first render of each level is a scene-cache miss.
+    const adventure::ui::Renderer renderer(adventure::ui::Theme{});
+    const adventure::levels::TerminalLevelFactory factory(renderer);
+    adventure::context::GameContext context;
+
+    for (const auto& level_path : levels) {
+      Clock::time_point begin = Clock::now();
+      std::ifstream file(level_path, std::ios::binary);
+      std::ostringstream buffer;
+      buffer << file.rdbuf();
+      std::istringstream content(buffer.str());
+      load_us += elapsed_us(begin);
+
+      begin = Clock::now();
+      adventure::parser::ParsedLevelData data;
+      try {
+        data = parser.parse(content);
+      } catch (const std::exception&) {
+        continue;  // --validate reports these
+      }
+      parse_us += elapsed_us(begin);
+
+      begin = Clock::now();
+      const std::unique_ptr<adventure::levels::ILevel> level = factory.create(std::move(data));
+      build_us += elapsed_us(begin);
+
+      context.set_current_level_path(level_path.string());
+      context.set_current_directory(level_path.parent_path().string());
+      begin = Clock::now();
+      level->render(discard, context);
+      render_us += elapsed_us(begin);
+
+      begin = Clock::now();
+      level->render(discard, context);
+      rerender_us += elapsed_us(begin);
+    }
+  }
+
+  const double samples = static_cast<double>(levels.size()) * kBenchRounds;
+  const auto row = [&](const char* name, double total_us) {
+    out << "  " << std::left << std::setw(16) << name << std::right << std::fixed
+        << std::setprecision(2) << std::setw(10) << total_us / samples << " us/level\n";
+  };
+  out << game_root.string() << ": " << levels.size() << " levels x " << kBenchRounds
+      << " rounds\n";
+  row("load", load_us);
+  row("parse", parse_us);
+  row("build", build_us);
+  row("render", render_us);
+  row("render (cached)", rerender_us);
+  row("transition", load_us + parse_us + build_us + render_us);
+  return kExitOk;
+}
+
+int run_footprint_command(const std::filesystem::path& game_root, std::ostream& out) {
+  const adventure::validation::MemoryFootprintReport report =
+      adventure::validation::measure_game_footprint(game_root);
+  if (report.levels.empty()) {
+    out << "No .level files found in " << game_root.string() << "\n";
+    return kExitUsage;
+  }
+
+  const auto parsed_json = [](const adventure::validation::ParsedBytes& bytes) {
+    return "{\"total\": " + std::to_string(bytes.total()) +
+           ", \"objects\": " + std::to_string(bytes.objects) +
+           ", \"strings\": " + std::to_string(bytes.strings) +
+           ", \"vectors\": " + std::to_string(bytes.vectors) +
+           ", \"maps\": " + std::to_string(bytes.maps) + "}";
+  };
+
+  out << "{\n";
+  out << "  \"game\": " << json_string(game_root.string()) << ",\n";
+  out << "  \"levels\": " << report.levels.size() << ",\n";
+  out << "  \"total_bytes\": " << report.total() << ",\n";
+  out << "  \"parsed_levels\": " << parsed_json(report.parsed) << ",\n";
+  out << "  \"ascii_art\": {\"bytes\": " << report.ascii_art
+      << ", \"files\": " << report.ascii_art_files << "},\n";
+  out << "  \"symbols\": {\"bytes\": " << report.symbols
+      << ", \"count\": " << report.symbol_count << "},\n";
+  out << "  \"game_context\": {\"initial\": " << report.context_initial
+      << ", \"peak\": " << report.context_peak << "},\n";
+  out << "  \"top_levels\": [";
+  const std::size_t top = std::min(kFootprintTopLevels, report.levels.size());
+  for (std::size_t i = 0; i < top; ++i) {
+    const auto& level = report.levels[i];
+    out << (i == 0 ? "\n" : ",\n") << "    {\"level\": "
+        << json_string(level.level.generic_string()) << ", \"bytes\": " << level.total()
+        << ", \"parsed\": " << parsed_json(level.parsed)
+        << ", \"ascii_art\": " << level.ascii_art << "}";
+  }
+  out << "\n  ]\n}\n";
+  return kExitOk;
+}
+
+}  // namespace adventure::cli
@@ -0,0 +1,33 @@
+#ifndef CLI_ADVENTURE_CLI_BATCH_COMMANDS_H_
+#define CLI_ADVENTURE_CLI_BATCH_COMMANDS_H_
+
+#include <filesystem>
+#include <istream>
+#include <ostream>
+
+namespace adventure::cli {
+
+// Exit statuses shared by the non-interactive commands.
+inline constexpr int kExitOk = 0;
+inline constexpr int kExitFailed = 1;  // validation issues found / game not won
+inline constexpr int kExitUsage = 2;   // bad arguments or unreadable input
+
+// Writes the validation report for one game as JSON. Returns kExitOk only when no issues were
+// found and a victory is reachable.
+int run_validate_command(const std::filesystem::path& game_root, std::ostream& out);
+
+// Plays one game headless: `script` supplies menu numbers and typed input line by line, and the
+// transcript is written without color. Returns kExitOk when the game ends in victory.
+int run_play_command(const std::filesystem::path& game_root, std::istream& script,
+                     std::ostream& out);
+
+// Times loading, parsing, level construction and scene rendering for every level of one game.
+int run_bench_command(const std::filesystem::path& game_root, std::ostream& out);
+
+// Writes the estimated resident memory of one game as JSON: parsed levels by container kind,
+// ASCII art, interned memory symbols and per-session GameContext size, plus the largest levels.
+int run_footprint_command(const std::filesystem::path& game_root, std::ostream& out);
+
+}  // namespace adventure::cli
+
+#endif  // CLI_ADVENTURE_CLI_BATCH_COMMANDS_H_
@@ -0,0 +1,405 @@
+#include "conditions/condition_program.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <utility>
+
+#include "parser/integer_literal.h"
+#include "parser/keyword_table.h"
+
+namespace adventure::conditions {
+namespace {
+
+using adventure::context::Symbol;
+
+enum class TokenKind {
+  kName,
+  kString,
+  kLeftParen,
+  kRightParen,
+  kNot,
+  kAnd,
+  kOr,
+  kHas,
+  kEquals,
+  kNotEquals,
+  kLess,
+  kLessEqual,
+  kGreater,
+  kGreaterEqual,
+  kEnd,
+};
+
+struct Token {
+  TokenKind kind = TokenKind::kEnd;
+  std::string_view text;
+};
+
+bool is_name_char(char ch) {
+  return std::isspace(static_cast<unsigned char>(ch)) == 0 &&
+         std::strchr("()!=&|\"<>", ch) == nullptr;
+}
+
+// Recursive descent over the expression grammar, emitting postfix code as each production
+// completes.
+class ExpressionCompiler {
+ public:
+  ExpressionCompiler(std::string_view text, ConditionProgram* program, std::string* error)
+      : text_(text), program_(program), error_(error) {}
+
+  bool compile() {
+    if (!advance() || !parse_or()) {
+      return false;
+    }
+    if (current_.kind != TokenKind::kEnd) {
+      return fail("Unexpected `" + std::string(current_.text) + "` in condition.");
+    }
+    return true;
+  }
+
+ private:
+  bool fail(std::string message) {
+    *error_ = std::move(message);
+    return false;
+  }
+
+  bool advance() {
+    while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_])) != 0) {
+      ++pos_;
+    }
+    if (pos_ == text_.size()) {
+      current_ = Token{TokenKind::kEnd, "end of condition"};
+      return true;
+    }
+
+    const std::size_t start = pos_;
+    const std::string_view rest = text_.substr(pos_);
+    const auto take = [&](TokenKind kind, std::size_t length) {
+      pos_ += length;
+      current_ = Token{kind, text_.substr(start, length)};
+      return true;
+    };
+    if (rest.compare(0, 2, "&&") == 0) {
+      return take(TokenKind::kAnd, 2);
+    }
+    if (rest.compare(0, 2, "||") == 0) {
+      return take(TokenKind::kOr, 2);
+    }
+    if (rest.compare(0, 2, "==") == 0) {
+      return take(TokenKind::kEquals, 2);
+    }
+    if (rest.compare(0, 2, "!=") == 0) {
+      return take(TokenKind::kNotEquals, 2);
+    }
+    if (rest.compare(0, 2, "<=") == 0) {
+      return take(TokenKind::kLessEqual, 2);
+    }
+    if (rest.compare(0, 2, ">=") == 0) {
+      return take(TokenKind::kGreaterEqual, 2);
+    }
+    switch (rest.front()) {
+      case '<':
+        return take(TokenKind::kLess, 1);
+      case '>':
+        return take(TokenKind::kGreater, 1);
+      case '(':
+        return take(TokenKind::kLeftParen, 1);
+      case ')':
+        return take(TokenKind::kRightParen, 1);
+      case '!':
+        return take(TokenKind::kNot, 1);
+      case '"': {
+        const std::size_t close = text_.find('"', start + 1);
+        if (close == std::string_view::npos) {
+          return fail("Unterminated quoted value in condition.");
+        }
+        pos_ = close + 1;
+        current_ = Token{TokenKind::kString, text_.substr(start + 1, close - start - 1)};
+        return true;
+      }
+      default:
+        break;
+    }
+    if (!is_name_char(rest.front())) {
+      return fail("Unexpected `" + std::string(1, rest.front()) + "` in condition.");
+    }
+
+    while (pos_ < text_.size() && is_name_char(text_[pos_])) {
+      ++pos_;
+    }
+    const std::string_view word = text_.substr(start, pos_ - start);
+    TokenKind kind = TokenKind::kName;
+    if (adventure::parser::equals_ignore_case(word, "and")) {
+      kind = TokenKind::kAnd;
+    } else if (adventure::parser::equals_ignore_case(word, "or")) {
+      kind = TokenKind::kOr;
+    } else if (adventure::parser::equals_ignore_case(word, "not")) {
+      kind = TokenKind::kNot;
+    } else if (adventure::parser::equals_ignore_case(word, "has")) {
+      kind = TokenKind::kHas;
+    }
+    current_ = Token{kind, word};
+    return true;
+  }
+
+  bool expect(TokenKind kind, const char* what) {
+    if (current_.kind != kind) {
+      return fail(std::string("Expected ") + what + " but found `" + std::string(current_.text) +
+                  "` in condition.");
+    }
+    return true;
+  }
+
+  bool parse_or() {
+    if (!parse_and()) {
+      return false;
+    }
+    while (current_.kind == TokenKind::kOr) {
+      if (!advance() || !parse_and()) {
+        return false;
+      }
+      program_->push_binary(OpCode::kOr);
+    }
+    return true;
+  }
+
+  bool parse_and() {
+    if (!parse_unary()) {
+      return false;
+    }
+    while (current_.kind == TokenKind::kAnd) {
+      if (!advance() || !parse_unary()) {
+        return false;
+      }
+      program_->push_binary(OpCode::kAnd);
+    }
+    return true;
+  }
+
+  bool parse_unary() {
+    if (++nesting_ > ConditionProgram::kMaxDepth) {
+      return fail("Condition is nested too deeply.");
+    }
+    bool ok = false;
+    if (current_.kind == TokenKind::kNot) {
+      ok = advance() && parse_unary();
+      if (ok) {
+        program_->push_not();
+      }
+    } else {
+      ok = parse_primary();
+    }
+    --nesting_;
+    return ok;
+  }
+
+  bool parse_primary() {
+    adventure::context::MemorySymbols& symbols = adventure::context::memory_symbols();
+    switch (current_.kind) {
+      case TokenKind::kLeftParen:
+        return advance() && parse_or() && expect(TokenKind::kRightParen, "`)`") && advance();
+      case TokenKind::kHas: {
+        if (!advance() || !expect(TokenKind::kLeftParen, "`(` after `has`") || !advance() ||
+            !expect(TokenKind::kName, "a value key")) {
+          return false;
+        }
+        program_->push_leaf(OpCode::kHasValue, symbols.intern(current_.text));
+        return advance() && expect(TokenKind::kRightParen, "`)`") && advance();
+      }
+      case TokenKind::kName: {
+        const Symbol name = symbols.intern(current_.text);
+        if (!advance()) {
+          return false;
+        }
+        OpCode ordering = OpCode::kNumberLess;
+        switch (current_.kind) {
+          case TokenKind::kEquals:
+          case TokenKind::kNotEquals:
+            return parse_equality(name);
+          case TokenKind::kLess:
+            break;
+          case TokenKind::kLessEqual:
+            ordering = OpCode::kNumberLessEqual;
+            break;
+          case TokenKind::kGreater:
+            ordering = OpCode::kNumberGreater;
+            break;
+          case TokenKind::kGreaterEqual:
+            ordering = OpCode::kNumberGreaterEqual;
+            break;
+          default:
+            program_->push_leaf(OpCode::kFlag, name);
+            return true;
+        }
+        const std::string op(current_.text);
+        std::int64_t number = 0;
+        if (!advance()) {
+          return false;
+        }
+        if (current_.kind != TokenKind::kName ||
+            !adventure::parser::parse_integer(current_.text, &number)) {
+          return fail("Expected a whole number after `" + op + "` but found `" +
+                      std::string(current_.text) + "` in condition.");
+        }
+        program_->push_number(ordering, name, number);
+        return advance();
+      }
+      default:
+        return fail("Expected a flag, `has(...)`, `not` or `(` but found `" +
+                    std::string(current_.text) + "` in condition.");
+    }
+  }
+
+  // `name == value` or `name != value`, with the operator as the current token.
+  bool parse_equality(Symbol name) {
+    const bool negate = current_.kind == TokenKind::kNotEquals;
+    if (!advance()) {
+      return false;
+    }
+    std::int64_t number = 0;
+    if (current_.kind == TokenKind::kName &&
+        adventure::parser::parse_integer(current_.text, &number)) {
+      program_->push_number(OpCode::kNumberEquals, name, number);
+    } else if (current_.kind == TokenKind::kName || current_.kind == TokenKind::kString) {
+      program_->push_leaf(OpCode::kValueEquals, name,
+                          adventure::context::memory_symbols().intern(current_.text));
+    } else {
+      return fail("Expected a value to compare with but found `" + std::string(current_.text) +
+                  "` in condition.");
+    }
+    if (negate) {
+      program_->push_not();
+    }
+    return advance();
+  }
+
+  std::string_view text_;
+  std::size_t pos_ = 0;
+  Token current_;
+  std::size_t nesting_ = 0;
+  ConditionProgram* program_;
+  std::string* error_;
+};
+
+}  // namespace
+
+bool ConditionProgram::evaluate(const adventure::context::GameContext& context) const {
+  struct ContextMemory {
+    const adventure::context::GameContext& context;
+    bool has_flag(Symbol flag) const { return context.has_memory_flag(flag); }
+    bool has_value(Symbol key) const { return context.has_memory_value(key); }
+    Symbol value_of(Symbol key) const { return context.memory_value_symbol(key); }
+    bool number_of(Symbol key, std::int64_t* value) const {
+      return context.memory_number(key, value);
+    }
+  };
+  return run(ContextMemory{context});
+}
+
+void ConditionProgram::push_leaf(OpCode op, Symbol a, Symbol b) {
+  code_.push_back(Instruction{op, a, b});
+  ++depth_;
+  max_depth_ = std::max(max_depth_, depth_);
+}
+
+void ConditionProgram::push_number(OpCode op, Symbol key, std::int64_t number) {
+  push_leaf(op, key);
+  code_.back().number = number;
+}
+
+void ConditionProgram::push_not() { code_.push_back(Instruction{OpCode::kNot}); }
+
+void ConditionProgram::push_binary(OpCode op) {
+  code_.push_back(Instruction{op});
+  --depth_;
+}
+
+void ConditionProgram::append_and(const ConditionProgram& other) {
+  if (other.empty()) {
+    return;
+  }
+  const bool joins = !empty();
+  max_depth_ = std::max(max_depth_, depth_ + other.max_depth_);
+  code_.insert(code_.end(), other.code_.begin(), other.code_.end());
+  depth_ += other.depth_;
+  if (joins) {
+    push_binary(OpCode::kAnd);
+  }
+}
+
+bool compile_expression(std::string_view expression, ConditionProgram* program,
+                        std::string* error) {
+  ConditionProgram compiled;
+  if (!ExpressionCompiler(expression, &compiled, error).compile()) {
+    return false;
+  }
+  if (compiled.max_depth() > ConditionProgram::kMaxDepth) {
+    *error = "Condition is nested too deeply.";
+    return false;
+  }
+  *program = std::move(compiled);
+  return true;
+}
+
+bool compile_guard(const std::vector<adventure::parser::OptionCondition>& conditions,
+                   std::string_view id, ConditionProgram* program, std::string* error) {
+  adventure::context::MemorySymbols& symbols = adventure::context::memory_symbols();
+  ConditionProgram guard;
+  const auto require = [&guard](OpCode op, Symbol a, Symbol b, bool negate) {
+    ConditionProgram leaf;
+    leaf.push_leaf(op, a, b);
+    if (negate) {
+      leaf.push_not();
+    }
+    guard.append_and(leaf);
+  };
+
+  for (const auto& condition : conditions) {
+    if (condition.option_id != id) {
+      continue;
+    }
+    for (const auto& flag : condition.required_flags) {
+      require(OpCode::kFlag, symbols.intern(flag), adventure::context::kNoSymbol, false);
+    }
+    for (const auto& flag : condition.forbidden_flags) {
+      require(OpCode::kFlag, symbols.intern(flag), adventure::context::kNoSymbol, true);
+    }
+    for (const auto& [key, value] : condition.required_values) {
+      std::int64_t number = 0;
+      if (adventure::parser::parse_integer(value, &number)) {
+        ConditionProgram leaf;
+        leaf.push_number(OpCode::kNumberEquals, symbols.intern(key), number);
+        guard.append_and(leaf);
+      } else {
+        require(OpCode::kValueEquals, symbols.intern(key), symbols.intern(value), false);
+      }
+    }
+    for (const auto& bound : condition.number_bounds) {
+      ConditionProgram leaf;
+      leaf.push_number(bound.at_most ? OpCode::kNumberLessEqual : OpCode::kNumberGreaterEqual,
+                       symbols.intern(bound.key), bound.bound);
+      guard.append_and(leaf);
+    }
+    for (const auto& key : condition.required_missing_values) {
+      require(OpCode::kHasValue, symbols.intern(key), adventure::context::kNoSymbol, true);
+    }
+    if (!condition.expression.empty()) {
+      ConditionProgram expression;
+      if (!compile_expression(condition.expression, &expression, error)) {
+        *error = "Condition for `" + condition.option_id + "`: " + *error;
+        return false;
+      }
+      guard.append_and(expression);
+    }
+  }
+
+  if (guard.max_depth() > ConditionProgram::kMaxDepth) {
+    *error = "Condition for `" + std::string(id) + "` is nested too deeply.";
+    return false;
+  }
+  *program = std::move(guard);
+  return true;
+}
+
+}  // namespace adventure::conditions
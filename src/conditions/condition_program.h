@@ -0,0 +1,176 @@
+#ifndef CLI_ADVENTURE_CONDITIONS_CONDITION_PROGRAM_H_
+#define CLI_ADVENTURE_CONDITIONS_CONDITION_PROGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "context/game_context.h"
+#include "context/memory_symbols.h"
+#include "parser/parsed_level.h"
+
+namespace adventure::conditions {
+
+enum class OpCode : std::uint8_t {
+  kFlag,         // push: flag `a` is set
+  kHasValue,     // push: value key `a` is set
+  kValueEquals,  // push: value key `a` holds value `b`
+  // push: value key `a` holds a number ==, <, <=, > or >= `number`; an unset key reads as 0 and
+  // text never matches
+  kNumberEquals,
+  kNumberLess,
+  kNumberLessEqual,
+  kNumberGreater,
+  kNumberGreaterEqual,
+  kNot,
+  kAnd,
+  kOr,
+};
+
+struct Instruction {
+  OpCode op;
+  adventure::context::Symbol a = adventure::context::kNoSymbol;
+  adventure::context::Symbol b = adventure::context::kNoSymbol;
+  std::int64_t number = 0;
+};
+
+// A condition compiled to postfix bytecode over interned memory symbols. The evaluation stack is
+// a single word of bits, so a check neither allocates nor compares strings.
+class ConditionProgram {
+ public:
+  static constexpr std::size_t kMaxDepth = 64;
+
+  bool empty() const { return code_.empty(); }
+  const std::vector<Instruction>& code() const { return code_; }
+  std::size_t max_depth() const { return max_depth_; }
+
+  // An empty program always passes.
+  bool evaluate(const adventure::context::GameContext& context) const;
+
+  // Runs against any memory exposing `bool has_flag(Symbol)`, `bool has_value(Symbol)`,
+  // `Symbol value_of(Symbol)` (kNoSymbol unless the key holds text) and
+  // `bool number_of(Symbol, std::int64_t*)` (false when the key holds text, 0 when unset), in the
+  // symbol space the program was compiled or remapped to.
+  template <typename Memory>
+  bool run(const Memory& memory) const;
+
+  // Copy with each operand replaced by `map(op, operand_index, symbol)`; operand_index is 0 for
+  // `a` and 1 for `b`. Moves a program into another symbol space, such as the state explorer's.
+  template <typename Map>
+  ConditionProgram remapped(Map map) const;
+
+  // Leaf instructions, and the combinators that join the previous one or two results.
+  void push_leaf(OpCode op, adventure::context::Symbol a,
+                 adventure::context::Symbol b = adventure::context::kNoSymbol);
+  void push_number(OpCode op, adventure::context::Symbol key, std::int64_t number);
+  void push_not();
+  void push_binary(OpCode op);
+  // Appends `other` as one more requirement: this AND other.
+  void append_and(const ConditionProgram& other);
+
+ private:
+  std::vector<Instruction> code_;
+  std::size_t depth_ = 0;  // stack depth after the last instruction
+  std::size_t max_depth_ = 0;
+};
+
+// Compiles an expression such as `has_key or (lockpick and not alarm_raised)`:
+//   - a bare name tests a flag; `has(key)` tests that a value is set;
+//   - `key == value` and `key != value` compare a value (quote values containing spaces); an
+//     unquoted whole number such as `10` compares the key's number instead of its text;
+//   - `key < N`, `<=`, `>` and `>=` compare a number with a whole number N;
+//   - `not`/`!`, `and`/`&&`, `or`/`||` in that precedence, and parentheses.
+// Keywords are case-insensitive. Returns false with `error` set on a syntax error or when
+// nesting exceeds ConditionProgram::kMaxDepth.
+bool compile_expression(std::string_view expression, ConditionProgram* program,
+                        std::string* error);
+
+// Everything `conditions` require of one option or input rule, ANDed: the classic
+// requires_*/forbids_* tokens, requires_at_least/at_most bounds and any `when` expression.
+// Returns false with `error` set when an expression does not compile.
+bool compile_guard(const std::vector<adventure::parser::OptionCondition>& conditions,
+                   std::string_view id, ConditionProgram* program, std::string* error);
+
+template <typename Memory>
+bool ConditionProgram::run(const Memory& memory) const {
+  if (code_.empty()) {
+    return true;
+  }
+  std::uint64_t stack = 0;  // bit 0 is the top
+  for (const Instruction& instruction : code_) {
+    switch (instruction.op) {
+      case OpCode::kFlag:
+        stack = (stack << 1) | (memory.has_flag(instruction.a) ? 1u : 0u);
+        break;
+      case OpCode::kHasValue:
+        stack = (stack << 1) | (memory.has_value(instruction.a) ? 1u : 0u);
+        break;
+      case OpCode::kValueEquals:
+        stack = (stack << 1) | (memory.value_of(instruction.a) == instruction.b ? 1u : 0u);
+        break;
+      case OpCode::kNumberEquals:
+      case OpCode::kNumberLess:
+      case OpCode::kNumberLessEqual:
+      case OpCode::kNumberGreater:
+      case OpCode::kNumberGreaterEqual: {
+        std::int64_t value = 0;
+        bool holds = memory.number_of(instruction.a, &value);
+        switch (instruction.op) {
+          case OpCode::kNumberEquals:
+            holds = holds && value == instruction.number;
+            break;
+          case OpCode::kNumberLess:
+            holds = holds && value < instruction.number;
+            break;
+          case OpCode::kNumberLessEqual:
+            holds = holds && value <= instruction.number;
+            break;
+          case OpCode::kNumberGreater:
+            holds = holds && value > instruction.number;
+            break;
+          default:
+            holds = holds && value >= instruction.number;
+            break;
+        }
+        stack = (stack << 1) | (holds ? 1u : 0u);
+        break;
+      }
+      case OpCode::kNot:
+        stack ^= 1u;
+        break;
+      case OpCode::kAnd: {
+        const std::uint64_t top = stack & 1u;
+        stack >>= 1;
+        stack &= ~std::uint64_t{1} | top;
+        break;
+      }
+      case OpCode::kOr: {
+        const std::uint64_t top = stack & 1u;
+        stack >>= 1;
+        stack |= top;
+        break;
+      }
+    }
+  }
+  return (stack & 1u) != 0;
+}
+
+template <typename Map>
+ConditionProgram ConditionProgram::remapped(Map map) const {
+  ConditionProgram copy = *this;
+  for (Instruction& instruction : copy.code_) {
+    if (instruction.a != adventure::context::kNoSymbol) {
+      instruction.a = map(instruction.op, 0, instruction.a);
+    }
+    if (instruction.b != adventure::context::kNoSymbol) {
+      instruction.b = map(instruction.op, 1, instruction.b);
+    }
+  }
+  return copy;
+}
+
+}  // namespace adventure::conditions
+
+#endif  // CLI_ADVENTURE_CONDITIONS_CONDITION_PROGRAM_H_
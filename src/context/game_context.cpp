@@ -2,6 +2,16 @@
 
 namespace adventure::context {
 
+std::int64_t add_saturating(std::int64_t value, std::int64_t delta) {
+  if (delta > 0 && value > INT64_MAX - delta) {
+    return INT64_MAX;
+  }
+  if (delta < 0 && value < INT64_MIN - delta) {
+    return INT64_MIN;
+  }
+  return value + delta;
+}
+
 const std::string& GameContext::current_directory() const { return current_directory_; }
 
 void GameContext::set_current_directory(std::string directory) {
@@ -37,7 +47,8 @@ const std::unordered_map<std::string, std::string>& GameContext::memory_values()
 }
 
 bool GameContext::has_memory_value(const std::string& key) const {
-  return memory_values_.find(key) != memory_values_.end();
+  return memory_values_.find(key) != memory_values_.end() ||
+         memory_numbers_.find(key) != memory_numbers_.end();
 }
 
 const std::string* GameContext::get_memory_value(const std::string& key) const {
@@ -49,10 +60,51 @@ const std::string* GameContext::get_memory_value(const std::string& key) const {
 }
 
 void GameContext::set_memory_value(std::string key, std::string value) {
+  ValueSlot& slot = value_slot(memory_symbols().intern(key));
+  slot.text = memory_symbols().intern(value);
+  if (slot.is_number) {
+    slot.is_number = false;
+    memory_numbers_.erase(key);
+  }
   memory_values_[std::move(key)] = std::move(value);
 }
 
-void GameContext::erase_memory_value(const std::string& key) { memory_values_.erase(key); }
+void GameContext::erase_memory_value(const std::string& key) {
+  const Symbol key_symbol = memory_symbols().find(key);
+  if (key_symbol < value_slots_.size()) {
+    value_slots_[key_symbol] = ValueSlot{};
+  }
+  memory_values_.erase(key);
+  memory_numbers_.erase(key);
+}
+
+const std::unordered_map<std::string, std::int64_t>& GameContext::memory_numbers() const {
+  return memory_numbers_;
+}
+
+const std::int64_t* GameContext::get_memory_number(const std::string& key) const {
+  const auto it = memory_numbers_.find(key);
+  if (it == memory_numbers_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void GameContext::set_memory_number(std::string key, std::int64_t value) {
+  ValueSlot& slot = value_slot(memory_symbols().intern(key));
+  if (slot.text != kNoSymbol) {
+    slot.text = kNoSymbol;
+    memory_values_.erase(key);
+  }
+  slot.is_number = true;
+  slot.number = value;
+  memory_numbers_[std::move(key)] = value;
+}
+
+void GameContext::add_memory_number(const std::string& key, std::int64_t delta) {
+  const std::int64_t* current = get_memory_number(key);
+  set_memory_number(key, add_saturating(current != nullptr ? *current : 0, delta));
+}
 
 const std::unordered_set<std::string>& GameContext::memory_flags() const {
   return memory_flags_;
@@ -62,8 +114,51 @@ bool GameContext::has_memory_flag(const std::string& flag) const {
   return memory_flags_.find(flag) != memory_flags_.end();
 }
 
-void GameContext::set_memory_flag(std::string flag) { memory_flags_.insert(std::move(flag)); }
+void GameContext::set_memory_flag(std::string flag) {
+  const Symbol symbol = memory_symbols().intern(flag);
+  if (symbol / 64 >= flag_bits_.size()) {
+    flag_bits_.resize(symbol / 64 + 1, 0);
+  }
+  flag_bits_[symbol / 64] |= std::uint64_t{1} << (symbol % 64);
+  memory_flags_.insert(std::move(flag));
+}
 
-void GameContext::clear_memory_flag(const std::string& flag) { memory_flags_.erase(flag); }
+void GameContext::clear_memory_flag(const std::string& flag) {
+  const Symbol symbol = memory_symbols().find(flag);
+  if (symbol != kNoSymbol && symbol / 64 < flag_bits_.size()) {
+    flag_bits_[symbol / 64] &= ~(std::uint64_t{1} << (symbol % 64));
+  }
+  memory_flags_.erase(flag);
+}
+
+bool GameContext::has_memory_flag(Symbol flag) const {
+  return flag / 64 < flag_bits_.size() && ((flag_bits_[flag / 64] >> (flag % 64)) & 1u) != 0;
+}
+
+Symbol GameContext::memory_value_symbol(Symbol key) const {
+  return key < value_slots_.size() ? value_slots_[key].text : kNoSymbol;
+}
+
+bool GameContext::has_memory_value(Symbol key) const {
+  return key < value_slots_.size() &&
+         (value_slots_[key].is_number || value_slots_[key].text != kNoSymbol);
+}
+
+bool GameContext::memory_number(Symbol key, std::int64_t* value) const {
+  if (key >= value_slots_.size()) {
+    *value = 0;
+    return true;
+  }
+  const ValueSlot& slot = value_slots_[key];
+  *value = slot.number;
+  return slot.text == kNoSymbol;
+}
+
+GameContext::ValueSlot& GameContext::value_slot(Symbol key) {
+  if (key >= value_slots_.size()) {
+    value_slots_.resize(key + 1);
+  }
+  return value_slots_[key];
+}
 
 }  // namespace adventure::context
@@ -1,12 +1,19 @@
 #ifndef CLI_ADVENTURE_CONTEXT_GAME_CONTEXT_H_
 #define CLI_ADVENTURE_CONTEXT_GAME_CONTEXT_H_
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <vector>
+
+#include "context/memory_symbols.h"
 
 namespace adventure::context {
 
+// `value + delta`, clamped to the int64 range instead of overflowing.
+std::int64_t add_saturating(std::int64_t value, std::int64_t delta);
+
 class GameContext {
  public:
   GameContext() = default;
@@ -28,17 +35,33 @@ class GameContext {
   bool is_victory() const;
   void set_victory(bool value);
 
+  // A value key holds either text or a number; setting one kind replaces the other, and
+  // has/erase cover both.
   const std::unordered_map<std::string, std::string>& memory_values() const;
   bool has_memory_value(const std::string& key) const;
   const std::string* get_memory_value(const std::string& key) const;
   void set_memory_value(std::string key, std::string value);
   void erase_memory_value(const std::string& key);
 
+  const std::unordered_map<std::string, std::int64_t>& memory_numbers() const;
+  const std::int64_t* get_memory_number(const std::string& key) const;
+  void set_memory_number(std::string key, std::int64_t value);
+  // Starts from 0 when `key` is unset or holds text.
+  void add_memory_number(const std::string& key, std::int64_t delta);
+
   const std::unordered_set<std::string>& memory_flags() const;
   bool has_memory_flag(const std::string& flag) const;
   void set_memory_flag(std::string flag);
   void clear_memory_flag(const std::string& flag);
 
+  // Symbol-indexed view of the same memory for compiled conditions; no hashing or allocation.
+  bool has_memory_flag(Symbol flag) const;
+  // The interned text stored under `key`, or kNoSymbol when it is unset or a number.
+  Symbol memory_value_symbol(Symbol key) const;
+  bool has_memory_value(Symbol key) const;
+  // False when `key` holds text; an unset key reads as 0.
+  bool memory_number(Symbol key, std::int64_t* value) const;
+
  private:
   std::string current_directory_;
   std::string current_level_path_;
@@ -46,7 +69,18 @@ class GameContext {
   bool game_over_ = false;
   bool victory_ = false;
   std::unordered_map<std::string, std::string> memory_values_;
+  std::unordered_map<std::string, std::int64_t> memory_numbers_;
   std::unordered_set<std::string> memory_flags_;
+
+  struct ValueSlot {
+    Symbol text = kNoSymbol;
+    bool is_number = false;
+    std::int64_t number = 0;
+  };
+  ValueSlot& value_slot(Symbol key);
+
+  std::vector<std::uint64_t> flag_bits_;
+  std::vector<ValueSlot> value_slots_;
 };
 
 }  // namespace adventure::context
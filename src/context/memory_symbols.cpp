@@ -0,0 +1,38 @@
+#include "context/memory_symbols.h"
+
+namespace adventure::context {
+
+Symbol MemorySymbols::intern(std::string_view name) {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = ids_.find(name);
+  if (it != ids_.end()) {
+    return it->second;
+  }
+  const Symbol symbol = static_cast<Symbol>(names_.size());
+  names_.emplace_back(name);
+  ids_.emplace(names_.back(), symbol);
+  return symbol;
+}
+
+Symbol MemorySymbols::find(std::string_view name) const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  const auto it = ids_.find(name);
+  return it == ids_.end() ? kNoSymbol : it->second;
+}
+
+std::string_view MemorySymbols::name(Symbol symbol) const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return symbol < names_.size() ? std::string_view(names_[symbol]) : std::string_view();
+}
+
+std::size_t MemorySymbols::size() const {
+  const std::lock_guard<std::mutex> lock(mutex_);
+  return names_.size();
+}
+
+MemorySymbols& memory_symbols() {
+  static MemorySymbols symbols;
+  return symbols;
+}
+
+}  // namespace adventure::context
@@ -0,0 +1,38 @@
+#ifndef CLI_ADVENTURE_CONTEXT_MEMORY_SYMBOLS_H_
+#define CLI_ADVENTURE_CONTEXT_MEMORY_SYMBOLS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace adventure::context {
+
+using Symbol = std::uint32_t;
+inline constexpr Symbol kNoSymbol = UINT32_MAX;
+
+// Process-wide ids for memory flag names, value keys and values. Compiled conditions and
+// GameContext intern through the same table so a check compares ids, never strings. Ids are
+// dense from 0 and names are never dropped.
+class MemorySymbols {
+ public:
+  Symbol intern(std::string_view name);
+  // kNoSymbol when `name` was never interned.
+  Symbol find(std::string_view name) const;
+  std::string_view name(Symbol symbol) const;
+  std::size_t size() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::deque<std::string> names_;  // stable addresses for the keys of ids_
+  std::unordered_map<std::string_view, Symbol> ids_;
+};
+
+MemorySymbols& memory_symbols();
+
+}  // namespace adventure::context
+
+#endif  // CLI_ADVENTURE_CONTEXT_MEMORY_SYMBOLS_H_
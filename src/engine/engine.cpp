@@ -17,15 +17,14 @@ void Engine::run(std::istream& in, std::ostream& out, adventure::context::GameCo
   }
 
   while (!context.is_game_over() && !context.is_victory()) {
-    const std::filesystem::path current_level_path(context.current_level_path());
-    context.set_current_directory(current_level_path.parent_path().string());
-
+    LoadedLevel* loaded = nullptr;
     try {
-      const adventure::parser::ParsedLevelData parsed_data =
-          parser_.parse_file(context.current_level_path());
-      std::unique_ptr<adventure::levels::ILevel> level = factory_.create(parsed_data);
-      level->render(out, context);
-      level->execute(in, out, context);
+      loaded = &load_level(context.current_level_path());
+      if (context.current_directory() != loaded->directory) {
+        context.set_current_directory(loaded->directory);
+      }
+      adventure::levels::render_level(loaded->level, out, context);
+      adventure::levels::execute_level(loaded->level, in, out, context);
     } catch (const std::exception& ex) {
       renderer_.render_structure_error(out,
                                        "Failed to load/execute level `" +
@@ -45,13 +44,31 @@ void Engine::run(std::istream& in, std::ostream& out, adventure::context::GameCo
       continue;
     }
 
-    const std::string resolved_path = resolve_next_level_path(
-        context.current_level_path(), context.next_level_request());
-    context.set_current_level_path(resolved_path);
+    auto target_it = loaded->resolved_targets.find(context.next_level_request());
+    if (target_it == loaded->resolved_targets.end()) {
+      target_it = loaded->resolved_targets
+                      .emplace(context.next_level_request(),
+                               resolve_next_level_path(context.current_level_path(),
+                                                       context.next_level_request()))
+                      .first;
+    }
+    context.set_current_level_path(target_it->second);
     context.clear_next_level_request();
   }
 }
 
+Engine::LoadedLevel& Engine::load_level(const std::string& level_path) {
+  const auto it = level_cache_.find(level_path);
+  if (it != level_cache_.end()) {
+    return it->second;
+  }
+
+  LoadedLevel loaded{factory_.create_inline(parser_.parse_file(level_path)),
+                     std::filesystem::path(level_path).parent_path().string(),
+                     {}};
+  return level_cache_.emplace(level_path, std::move(loaded)).first->second;
+}
+
 std::string Engine::resolve_next_level_path(const std::string& current_level_path,
                                             const std::string& relative_or_absolute_next) {
   const std::filesystem::path next_path(relative_or_absolute_next);
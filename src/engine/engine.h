@@ -3,8 +3,11 @@
 
 #include <istream>
 #include <ostream>
+#include <string>
+#include <unordered_map>
 
 #include "context/game_context.h"
+#include "levels/terminal_level.h"
 #include "levels/terminal_level_factory.h"
 #include "parser/tag_parser.h"
 #include "ui/renderer.h"
@@ -19,12 +22,23 @@ class Engine {
   void run(std::istream& in, std::ostream& out, adventure::context::GameContext& context);
 
  private:
+  struct LoadedLevel {
+    adventure::levels::TerminalLevel level;  // inline; the level kind was chosen at load
+    std::string directory;
+    // Next-level requests already resolved against this level's path.
+    std::unordered_map<std::string, std::string> resolved_targets;
+  };
+
+  // Levels hold no per-visit state, so each file is parsed and built once per engine; like the
+  // renderer's scene cache, edits made to a level file during a session are not picked up.
+  LoadedLevel& load_level(const std::string& level_path);
   static std::string resolve_next_level_path(const std::string& current_level_path,
                                              const std::string& relative_or_absolute_next);
 
   adventure::ui::Renderer renderer_;
   adventure::parser::TagParser parser_;
   adventure::levels::TerminalLevelFactory factory_;
+  std::unordered_map<std::string, LoadedLevel> level_cache_;
 };
 
 }  // namespace adventure::engine
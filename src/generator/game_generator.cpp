@@ -0,0 +1,207 @@
+#include "generator/game_generator.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace adventure::generator {
+namespace {
+
+constexpr std::size_t kFolderFanOut = 8;
+
+const char* const kWords[] = {"ancient", "bridge", "candle", "dust",   "ember",  "fog",
+                              "granite", "hollow", "iron",   "lantern", "moss",  "north",
+                              "oak",     "pale",   "quiet",  "rust",   "stone", "torch",
+                              "umber",   "vault",  "wind",   "yew"};
+constexpr std::size_t kWordCount = sizeof(kWords) / sizeof(kWords[0]);
+
+// splitmix64: tiny, fast and identical on every standard library, unlike <random>
+// distributions.
+class Rng {
+ public:
+  explicit Rng(std::uint64_t seed) : state_(seed) {}
+
+  std::uint64_t next() {
+    std::uint64_t z = (state_ += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+  }
+
+  std::size_t below(std::size_t bound) { return static_cast<std::size_t>(next() % bound); }
+
+  bool chance(double probability) {
+    return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0) < probability;
+  }
+
+ private:
+  std::uint64_t state_;
+};
+
+std::filesystem::path level_path(std::size_t level, std::size_t depth) {
+  if (level == 0) {
+    return "start.level";
+  }
+  std::filesystem::path path;
+  std::size_t bucket = level;
+  for (std::size_t d = 0; d < depth; ++d) {
+    path /= (d == 0 ? "area_" : "part_") + std::to_string(bucket % kFolderFanOut);
+    bucket /= kFolderFanOut;
+  }
+  return path / ("level_" + std::to_string(level) + ".level");
+}
+
+std::string relative_target(const std::filesystem::path& from_level,
+                            const std::filesystem::path& to_file) {
+  const std::filesystem::path from_directory = from_level.parent_path();
+  const std::string text = from_directory.empty()
+                               ? to_file.generic_string()
+                               : to_file.lexically_relative(from_directory).generic_string();
+  return text.rfind("..", 0) == 0 ? text : "./" + text;
+}
+
+std::string sentence(Rng* rng, std::size_t words) {
+  std::string text;
+  for (std::size_t i = 0; i < words; ++i) {
+    text += (i == 0 ? "" : " ") + std::string(kWords[rng->below(kWordCount)]);
+  }
+  text[0] = static_cast<char>(text[0] - 'a' + 'A');
+  return text + ".";
+}
+
+class GameWriter {
+ public:
+  explicit GameWriter(std::filesystem::path root) : root_(std::move(root)) {
+    std::filesystem::create_directories(root_);
+  }
+
+  void write(const std::filesystem::path& relative, const std::string& text) {
+    const std::filesystem::path parent = relative.parent_path();
+    if (!parent.empty() && created_.insert(parent.generic_string()).second) {
+      std::filesystem::create_directories(root_ / parent);
+    }
+    std::ofstream out(root_ / relative, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+      throw std::runtime_error("Could not write " + (root_ / relative).string());
+    }
+    out << text;
+    ++stats_.files_written;
+    stats_.bytes_written += text.size();
+  }
+
+  const GeneratorStats& stats() const { return stats_; }
+
+ private:
+  std::filesystem::path root_;
+  std::unordered_set<std::string> created_;
+  GeneratorStats stats_;
+};
+
+}  // namespace
+
+GeneratorStats generate_game(const std::filesystem::path& game_root,
+                             const GeneratorOptions& options) {
+  if (options.level_count == 0 || options.branching == 0) {
+    throw std::invalid_argument("A generated game needs at least one level and one option.");
+  }
+  if (std::filesystem::exists(game_root) && !std::filesystem::is_empty(game_root)) {
+    throw std::invalid_argument("Output directory is not empty: " + game_root.string());
+  }
+
+  Rng rng(options.seed);
+  const std::size_t count = options.level_count;
+  const std::filesystem::path win = "endings/win.level";
+  const std::filesystem::path lose = "endings/lose.level";
+  const bool has_lose = options.branching > 1;  // only branches can lead to it
+
+  // Plan memory rules first: level `writer` sets a flag and a value on its way forward, and a
+  // later level `reader` offers an extra option gated on both.
+  std::vector<std::pair<std::size_t, std::size_t>> rules;  // (reader, writer)
+  for (std::size_t writer = 0; writer + 1 < count; ++writer) {
+    if (rng.chance(options.rule_density)) {
+      rules.emplace_back(writer + 1 + rng.below(count - writer - 1), writer);
+    }
+  }
+  std::sort(rules.begin(), rules.end());
+  std::vector<bool> writes(count, false);
+  for (const auto& rule : rules) {
+    writes[rule.second] = true;
+  }
+
+  GameWriter writer(game_root);
+  for (std::size_t art = 0; art < options.art_files; ++art) {
+    std::string text = "[default_color=bright_cyan]\n";
+    for (std::size_t line = 0; line < 4; ++line) {
+      text += std::string(4 + rng.below(20), ' ') + std::string(4 + rng.below(12), '#') + "\n";
+    }
+    writer.write("art/art_" + std::to_string(art) + ".txt", text);
+  }
+
+  auto next_rule = rules.begin();
+  for (std::size_t level = 0; level < count; ++level) {
+    const std::filesystem::path path = level_path(level, options.directory_depth);
+    const auto random_target = [&]() {
+      const std::size_t pick = rng.below(has_lose ? count + 1 : count);
+      return pick == count ? lose : level_path(pick, options.directory_depth);
+    };
+
+    std::string text = "[HEADER]\nid: level_" + std::to_string(level) + "\ntitle: " +
+                       (level == 0 ? std::string("Generated Adventure") : sentence(&rng, 2)) +
+                       "\n";
+    if (options.art_files > 0) {
+      text += "ascii_art: " +
+              relative_target(path, "art/art_" + std::to_string(rng.below(options.art_files)) +
+                                        ".txt") +
+              "\n";
+    }
+    text += "\n[CONTENT]\n";
+    for (std::size_t line = 0; line < options.content_lines; ++line) {
+      text += sentence(&rng, 6 + rng.below(8)) + "\n";
+    }
+
+    text += "\n[OPTIONS]\n";
+    const std::filesystem::path forward =
+        level + 1 == count ? win : level_path(level + 1, options.directory_depth);
+    text += "forward | " + sentence(&rng, 3) + " -> " + relative_target(path, forward) + "\n";
+    for (std::size_t option = 1; option < options.branching; ++option) {
+      // The last level's first branch always loses, so the game-over ending is reachable.
+      const std::filesystem::path target =
+          (level + 1 == count && option == 1) ? lose : random_target();
+      text += "branch_" + std::to_string(option) + " | " + sentence(&rng, 3) + " -> " +
+              relative_target(path, target) + "\n";
+    }
+    std::string conditions;
+    for (; next_rule != rules.end() && next_rule->first == level; ++next_rule) {
+      const std::string id = std::to_string(next_rule->second);
+      text += "secret_" + id + " | " + sentence(&rng, 4) + " -> " +
+              relative_target(path, random_target()) + "\n";
+      conditions += "option=secret_" + id + " requires_flag=seen_" + id + "\n";
+      conditions += "option=secret_" + id + " requires_value=mark_" + id + ":set\n";
+    }
+
+    text += "\n[DIRECTIVES]\ninput_mode: choice\n";
+    if (writes[level]) {
+      const std::string id = std::to_string(level);
+      text += "\n[MEMORY]\non_enter add_flag=seen_" + id + "\n";
+      text += "\n[OPTION_EFFECTS]\noption=forward set_value=mark_" + id + ":set\n";
+    }
+    if (!conditions.empty()) {
+      text += "\n[OPTION_CONDITIONS]\n" + conditions;
+    }
+    writer.write(path, text);
+  }
+
+  writer.write(win, "[HEADER]\ntitle: Victory\n\n[CONTENT]\n" + sentence(&rng, 8) +
+                    "\n\n[DIRECTIVES]\ninput_mode: endgame\nresult: victory\n");
+  if (has_lose) {
+    writer.write(lose, "[HEADER]\ntitle: Defeat\n\n[CONTENT]\n" + sentence(&rng, 8) +
+                       "\n\n[DIRECTIVES]\ninput_mode: endgame\nresult: game_over\n");
+  }
+  return writer.stats();
+}
+
+}  // namespace adventure::generator
@@ -0,0 +1,34 @@
+#ifndef CLI_ADVENTURE_GENERATOR_GAME_GENERATOR_H_
+#define CLI_ADVENTURE_GENERATOR_GAME_GENERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+namespace adventure::generator {
+
+struct GeneratorOptions {
+  std::uint64_t seed = 1;
+  std::size_t level_count = 1000;   // playable levels, not counting the two endings
+  std::size_t branching = 3;        // options per level
+  std::size_t directory_depth = 2;  // folder levels below the game root
+  std::size_t content_lines = 6;    // [CONTENT] lines per level
+  std::size_t art_files = 8;        // shared ASCII art files; 0 disables ascii_art headers
+  double rule_density = 0.2;        // fraction of levels that write memory read elsewhere
+};
+
+struct GeneratorStats {
+  std::size_t files_written = 0;
+  std::uintmax_t bytes_written = 0;
+};
+
+// Writes a complete game under `game_root` (which must not exist or be empty). Output depends
+// only on the options, including the seed. Every level is reachable from start.level, each
+// level's first option continues towards the victory ending so there are no trap cycles, and
+// every flag or value that is written is also checked, so the game validates cleanly.
+GeneratorStats generate_game(const std::filesystem::path& game_root,
+                             const GeneratorOptions& options);
+
+}  // namespace adventure::generator
+
+#endif  // CLI_ADVENTURE_GENERATOR_GAME_GENERATOR_H_
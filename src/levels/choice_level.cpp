@@ -13,8 +13,9 @@ namespace adventure::levels {
 ChoiceLevel::ChoiceLevel(adventure::parser::ParsedLevelData data,
                          const adventure::ui::Renderer& renderer)
     : title_(build_title(data.header)),
-      ascii_art_path_(data.header.count("ascii_art") != 0 ? data.header.at("ascii_art") : ""),
+      ascii_art_path_(adventure::parser::take_field(&data.header, "ascii_art")),
       content_lines_(std::move(data.content_lines)),
+      streamed_content_(std::move(data.streamed_content)),
       options_(std::move(data.options)),
       on_enter_memory_(std::move(data.on_enter_memory)),
       option_conditions_(std::move(data.option_conditions)),
@@ -24,15 +25,26 @@ ChoiceLevel::ChoiceLevel(adventure::parser::ParsedLevelData data,
     options_[i].id = resolve_option_id(options_[i], i);
     option_ids_.insert(options_[i].id);
   }
+
+  option_guards_.resize(options_.size());
+  for (std::size_t i = 0; i < options_.size(); ++i) {
+    if (!adventure::conditions::compile_guard(option_conditions_, options_[i].id,
+                                              &option_guards_[i], &guard_error_)) {
+      break;
+    }
+  }
 }
 
 void ChoiceLevel::render(std::ostream& out,
                          const adventure::context::GameContext& context) const {
-  renderer_.render_scene(out, title_, content_lines_, context.current_directory(), ascii_art_path_);
+  renderer_.render_cached_scene(out, context.current_level_path(), title_, content_lines_,
+                                context.current_directory(), ascii_art_path_);
 }
 
 void ChoiceLevel::execute(std::istream& in, std::ostream& out,
                           adventure::context::GameContext& context) {
+  // Paging needs the input stream, so streamed content is shown here rather than in render().
+  renderer_.render_streamed_content(in, out, streamed_content_);
   apply_mutations(on_enter_memory_, context);
 
   std::string invalid_option_id;
@@ -43,6 +55,12 @@ void ChoiceLevel::execute(std::istream& in, std::ostream& out,
     return;
   }
 
+  if (!guard_error_.empty()) {
+    context.set_game_over(true);
+    renderer_.render_structure_error(out, guard_error_);
+    return;
+  }
+
   if (options_.empty()) {
     context.set_game_over(true);
     renderer_.render_structure_error(out, "Choice level has no options.");
@@ -51,14 +69,14 @@ void ChoiceLevel::execute(std::istream& in, std::ostream& out,
 
   std::vector<std::size_t> visible_option_indices;
   std::vector<std::string> labels;
+  visible_option_indices.reserve(options_.size());
   labels.reserve(options_.size());
   for (std::size_t index = 0; index < options_.size(); ++index) {
-    const auto& option = options_[index];
-    if (!conditions_pass_for_option(option.id, context)) {
+    if (!option_guards_[index].evaluate(context)) {
       continue;
     }
     visible_option_indices.push_back(index);
-    labels.push_back(option.text);
+    labels.push_back(options_[index].text);
   }
 
   if (labels.empty()) {
@@ -68,15 +86,15 @@ void ChoiceLevel::execute(std::istream& in, std::ostream& out,
     return;
   }
 
+  static const std::string kInteractivePrompt =
+      "Use Up/Down arrows and Enter to choose (type to filter):";
+  static const std::string kFallbackPrompt = "Interactive menu unavailable; use number input:";
   const bool is_interactive = adventure::ui::supports_interactive_menu(in, out);
-  const std::string prompt =
-      is_interactive
-          ? "Use Up/Down arrows and Enter to choose:"
-          : "Interactive menu unavailable; use number input:";
+  const std::string& prompt = is_interactive ? kInteractivePrompt : kFallbackPrompt;
 
   try {
     const adventure::ui::MenuSelection selection =
-        adventure::ui::pick_option(in, out, labels, prompt, renderer_.theme());
+        adventure::ui::pick_option(in, out, labels, prompt, renderer_.compiled_theme());
     if (is_interactive) {
       renderer_.clear_last_scene(out, selection.rendered_lines);
     }
@@ -96,8 +114,7 @@ void ChoiceLevel::execute(std::istream& in, std::ostream& out,
   }
 }
 
-std::string ChoiceLevel::build_title(
-    const std::unordered_map<std::string, std::string>& header) {
+std::string ChoiceLevel::build_title(const adventure::parser::FieldMap& header) {
   const auto title_it = header.find("title");
   if (title_it != header.end() && !title_it->second.empty()) {
     return title_it->second;
@@ -119,42 +136,6 @@ std::string ChoiceLevel::resolve_option_id(const adventure::parser::LevelOption&
   return "option_" + std::to_string(index + 1);
 }
 
-bool ChoiceLevel::conditions_pass_for_option(
-    const std::string& option_id, const adventure::context::GameContext& context) const {
-  for (const auto& condition : option_conditions_) {
-    if (condition.option_id != option_id) {
-      continue;
-    }
-
-    for (const auto& flag : condition.required_flags) {
-      if (!context.has_memory_flag(flag)) {
-        return false;
-      }
-    }
-
-    for (const auto& flag : condition.forbidden_flags) {
-      if (context.has_memory_flag(flag)) {
-        return false;
-      }
-    }
-
-    for (const auto& requirement : condition.required_values) {
-      const std::string* value = context.get_memory_value(requirement.first);
-      if (value == nullptr || *value != requirement.second) {
-        return false;
-      }
-    }
-
-    for (const auto& missing_key : condition.required_missing_values) {
-      if (context.has_memory_value(missing_key)) {
-        return false;
-      }
-    }
-  }
-
-  return true;
-}
-
 void ChoiceLevel::apply_mutations(
     const std::vector<adventure::parser::MemoryMutation>& mutations,
     adventure::context::GameContext& context) const {
@@ -172,6 +153,12 @@ void ChoiceLevel::apply_mutations(
       case adventure::parser::MemoryMutation::Kind::kEraseValue:
         context.erase_memory_value(mutation.key);
         break;
+      case adventure::parser::MemoryMutation::Kind::kSetNumber:
+        context.set_memory_number(mutation.key, mutation.number);
+        break;
+      case adventure::parser::MemoryMutation::Kind::kAddNumber:
+        context.add_memory_number(mutation.key, mutation.number);
+        break;
     }
   }
 }
@@ -3,9 +3,9 @@
 
 #include <string>
 #include <unordered_set>
-#include <unordered_map>
 #include <vector>
 
+#include "conditions/condition_program.h"
 #include "levels/ilevel.h"
 #include "parser/parsed_level.h"
 #include "ui/renderer.h"
@@ -22,24 +22,25 @@ class ChoiceLevel final : public ILevel {
                adventure::context::GameContext& context) override;
 
  private:
-  static std::string build_title(
-      const std::unordered_map<std::string, std::string>& header);
+  static std::string build_title(const adventure::parser::FieldMap& header);
   static std::string resolve_option_id(const adventure::parser::LevelOption& option,
                                        std::size_t index);
-  bool conditions_pass_for_option(const std::string& option_id,
-                                  const adventure::context::GameContext& context) const;
   void apply_mutations(const std::vector<adventure::parser::MemoryMutation>& mutations,
                        adventure::context::GameContext& context) const;
   bool validate_rule_option_ids(std::string* invalid_option_id) const;
 
   std::string title_;
   std::string ascii_art_path_;
-  std::vector<std::string> content_lines_;
+  adventure::parser::TextLines content_lines_;
+  adventure::parser::StreamedContent streamed_content_;
   std::vector<adventure::parser::LevelOption> options_;
   std::vector<adventure::parser::MemoryMutation> on_enter_memory_;
   std::vector<adventure::parser::OptionCondition> option_conditions_;
   std::vector<adventure::parser::OptionEffect> option_effects_;
   std::unordered_set<std::string> option_ids_;
+  // One compiled guard per option, index-aligned with options_.
+  std::vector<adventure::conditions::ConditionProgram> option_guards_;
+  std::string guard_error_;
   const adventure::ui::Renderer& renderer_;
 };
 
@@ -8,18 +8,21 @@ namespace adventure::levels {
 EndGameLevel::EndGameLevel(adventure::parser::ParsedLevelData data,
                            const adventure::ui::Renderer& renderer)
     : title_(build_title(data.header)),
-      ascii_art_path_(data.header.count("ascii_art") != 0 ? data.header.at("ascii_art") : ""),
+      ascii_art_path_(adventure::parser::take_field(&data.header, "ascii_art")),
       content_lines_(std::move(data.content_lines)),
+      streamed_content_(std::move(data.streamed_content)),
       directives_(std::move(data.directives)),
       renderer_(renderer) {}
 
 void EndGameLevel::render(std::ostream& out,
                           const adventure::context::GameContext& context) const {
-  renderer_.render_scene(out, title_, content_lines_, context.current_directory(), ascii_art_path_);
+  renderer_.render_cached_scene(out, context.current_level_path(), title_, content_lines_,
+                                context.current_directory(), ascii_art_path_);
 }
 
 void EndGameLevel::execute(std::istream& in, std::ostream& out,
                            adventure::context::GameContext& context) {
+  renderer_.render_streamed_content(in, out, streamed_content_);
   const bool is_interactive = adventure::ui::supports_interactive_menu(in, out);
   const std::string continue_prompt = "Press Enter to return to Main Menu...";
   const auto result_it = directives_.find("result");
@@ -57,8 +60,7 @@ void EndGameLevel::execute(std::istream& in, std::ostream& out,
   context.set_game_over(true);
 }
 
-std::string EndGameLevel::build_title(
-    const std::unordered_map<std::string, std::string>& header) {
+std::string EndGameLevel::build_title(const adventure::parser::FieldMap& header) {
   const auto title_it = header.find("title");
   if (title_it != header.end() && !title_it->second.empty()) {
     return title_it->second;
@@ -2,7 +2,6 @@
 #define CLI_ADVENTURE_LEVELS_END_GAME_LEVEL_H_
 
 #include <string>
-#include <unordered_map>
 #include <vector>
 
 #include "levels/ilevel.h"
@@ -21,13 +20,13 @@ class EndGameLevel final : public ILevel {
                adventure::context::GameContext& context) override;
 
  private:
-  static std::string build_title(
-      const std::unordered_map<std::string, std::string>& header);
+  static std::string build_title(const adventure::parser::FieldMap& header);
 
   std::string title_;
   std::string ascii_art_path_;
-  std::vector<std::string> content_lines_;
-  std::unordered_map<std::string, std::string> directives_;
+  adventure::parser::TextLines content_lines_;
+  adventure::parser::StreamedContent streamed_content_;
+  adventure::parser::FieldMap directives_;
   const adventure::ui::Renderer& renderer_;
 };
 
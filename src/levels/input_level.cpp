@@ -6,6 +6,7 @@
 #include <string>
 #include <utility>
 
+#include "ui/latency_recorder.h"
 #include "ui/terminal_menu.h"
 
 namespace adventure::levels {
@@ -25,8 +26,9 @@ bool parse_bool(const std::string& value) {
 InputLevel::InputLevel(adventure::parser::ParsedLevelData data,
                        const adventure::ui::Renderer& renderer)
     : title_(build_title(data.header)),
-      ascii_art_path_(data.header.count("ascii_art") != 0 ? data.header.at("ascii_art") : ""),
+      ascii_art_path_(adventure::parser::take_field(&data.header, "ascii_art")),
       content_lines_(std::move(data.content_lines)),
+      streamed_content_(std::move(data.streamed_content)),
       input_rules_(std::move(data.input_rules)),
       on_enter_memory_(std::move(data.on_enter_memory)),
       option_conditions_(std::move(data.option_conditions)),
@@ -37,14 +39,23 @@ InputLevel::InputLevel(adventure::parser::ParsedLevelData data,
     rule_ids_.insert(input_rules_[i].id);
   }
 
+  rule_guards_.resize(input_rules_.size());
+  for (std::size_t i = 0; i < input_rules_.size(); ++i) {
+    if (!adventure::conditions::compile_guard(option_conditions_, input_rules_[i].id,
+                                              &rule_guards_[i], &guard_error_)) {
+      break;
+    }
+  }
+
   if (data.directives.find("input_prompt") != data.directives.end()) {
-    input_prompt_ = data.directives.at("input_prompt");
+    input_prompt_ = adventure::parser::take_field(&data.directives, "input_prompt");
   }
   if (data.directives.find("input_invalid_message") != data.directives.end()) {
-    input_invalid_message_ = data.directives.at("input_invalid_message");
+    input_invalid_message_ =
+        adventure::parser::take_field(&data.directives, "input_invalid_message");
   }
   if (data.directives.find("input_match") != data.directives.end()) {
-    input_match_mode_ = data.directives.at("input_match");
+    input_match_mode_ = adventure::parser::take_field(&data.directives, "input_match");
   }
   if (data.directives.find("input_case_sensitive") != data.directives.end()) {
     input_case_sensitive_ = parse_bool(data.directives.at("input_case_sensitive"));
@@ -53,11 +64,13 @@ InputLevel::InputLevel(adventure::parser::ParsedLevelData data,
 
 void InputLevel::render(std::ostream& out,
                         const adventure::context::GameContext& context) const {
-  renderer_.render_scene(out, title_, content_lines_, context.current_directory(), ascii_art_path_);
+  renderer_.render_cached_scene(out, context.current_level_path(), title_, content_lines_,
+                                context.current_directory(), ascii_art_path_);
 }
 
 void InputLevel::execute(std::istream& in, std::ostream& out,
                          adventure::context::GameContext& context) {
+  renderer_.render_streamed_content(in, out, streamed_content_);
   apply_mutations(on_enter_memory_, context);
   const bool is_interactive = adventure::ui::supports_interactive_menu(in, out);
   std::size_t transient_lines = 1;  // initial prompt line
@@ -71,6 +84,12 @@ void InputLevel::execute(std::istream& in, std::ostream& out,
     return;
   }
 
+  if (!guard_error_.empty()) {
+    context.set_game_over(true);
+    renderer_.render_structure_error(out, guard_error_);
+    return;
+  }
+
   if (input_rules_.empty()) {
     context.set_game_over(true);
     renderer_.render_structure_error(out, "Input level has no INPUT_RULES.");
@@ -80,9 +99,11 @@ void InputLevel::execute(std::istream& in, std::ostream& out,
   out << "\n" << input_prompt_ << " ";
   std::string user_input;
   while (std::getline(in, user_input)) {
+    adventure::ui::latency_recorder().input_committed();
     bool matched = false;
-    for (const auto& rule : input_rules_) {
-      if (!conditions_pass_for_rule(rule.id, context)) {
+    for (std::size_t index = 0; index < input_rules_.size(); ++index) {
+      const auto& rule = input_rules_[index];
+      if (!rule_guards_[index].evaluate(context)) {
         continue;
       }
       if (!is_rule_match(rule, user_input)) {
@@ -114,7 +135,7 @@ void InputLevel::execute(std::istream& in, std::ostream& out,
   context.set_game_over(true);
 }
 
-std::string InputLevel::build_title(const std::unordered_map<std::string, std::string>& header) {
+std::string InputLevel::build_title(const adventure::parser::FieldMap& header) {
   const auto title_it = header.find("title");
   if (title_it != header.end() && !title_it->second.empty()) {
     return title_it->second;
@@ -145,37 +166,6 @@ std::string InputLevel::normalize_input(std::string value, bool case_sensitive)
   return value;
 }
 
-bool InputLevel::conditions_pass_for_rule(
-    const std::string& rule_id, const adventure::context::GameContext& context) const {
-  for (const auto& condition : option_conditions_) {
-    if (condition.option_id != rule_id) {
-      continue;
-    }
-    for (const auto& flag : condition.required_flags) {
-      if (!context.has_memory_flag(flag)) {
-        return false;
-      }
-    }
-    for (const auto& flag : condition.forbidden_flags) {
-      if (context.has_memory_flag(flag)) {
-        return false;
-      }
-    }
-    for (const auto& requirement : condition.required_values) {
-      const std::string* value = context.get_memory_value(requirement.first);
-      if (value == nullptr || *value != requirement.second) {
-        return false;
-      }
-    }
-    for (const auto& missing_key : condition.required_missing_values) {
-      if (context.has_memory_value(missing_key)) {
-        return false;
-      }
-    }
-  }
-  return true;
-}
-
 void InputLevel::apply_mutations(const std::vector<adventure::parser::MemoryMutation>& mutations,
                                  adventure::context::GameContext& context) const {
   for (const auto& mutation : mutations) {
@@ -192,6 +182,12 @@ void InputLevel::apply_mutations(const std::vector<adventure::parser::MemoryMuta
       case adventure::parser::MemoryMutation::Kind::kEraseValue:
         context.erase_memory_value(mutation.key);
         break;
+      case adventure::parser::MemoryMutation::Kind::kSetNumber:
+        context.set_memory_number(mutation.key, mutation.number);
+        break;
+      case adventure::parser::MemoryMutation::Kind::kAddNumber:
+        context.add_memory_number(mutation.key, mutation.number);
+        break;
     }
   }
 }
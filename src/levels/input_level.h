@@ -2,10 +2,10 @@
 #define CLI_ADVENTURE_LEVELS_INPUT_LEVEL_H_
 
 #include <string>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "conditions/condition_program.h"
 #include "levels/ilevel.h"
 #include "parser/parsed_level.h"
 #include "ui/renderer.h"
@@ -22,13 +22,10 @@ class InputLevel final : public ILevel {
                adventure::context::GameContext& context) override;
 
  private:
-  static std::string build_title(
-      const std::unordered_map<std::string, std::string>& header);
+  static std::string build_title(const adventure::parser::FieldMap& header);
   static std::string resolve_rule_id(const adventure::parser::InputRule& rule, std::size_t index);
   static std::string normalize_input(std::string value, bool case_sensitive);
 
-  bool conditions_pass_for_rule(const std::string& rule_id,
-                                const adventure::context::GameContext& context) const;
   void apply_mutations(const std::vector<adventure::parser::MemoryMutation>& mutations,
                        adventure::context::GameContext& context) const;
   bool validate_rule_ids(std::string* invalid_rule_id) const;
@@ -36,12 +33,16 @@ class InputLevel final : public ILevel {
 
   std::string title_;
   std::string ascii_art_path_;
-  std::vector<std::string> content_lines_;
+  adventure::parser::TextLines content_lines_;
+  adventure::parser::StreamedContent streamed_content_;
   std::vector<adventure::parser::InputRule> input_rules_;
   std::vector<adventure::parser::MemoryMutation> on_enter_memory_;
   std::vector<adventure::parser::OptionCondition> option_conditions_;
   std::vector<adventure::parser::OptionEffect> option_effects_;
   std::unordered_set<std::string> rule_ids_;
+  // One compiled guard per rule, index-aligned with input_rules_.
+  std::vector<adventure::conditions::ConditionProgram> rule_guards_;
+  std::string guard_error_;
   std::string input_prompt_ = "What do you do?";
   std::string input_invalid_message_ = "Nothing happens. Try again.";
   std::string input_match_mode_ = "contains";
@@ -0,0 +1,26 @@
+#include "levels/terminal_level.h"
+
+namespace adventure::levels {
+namespace {
+
+ILevel& as_level(std::unique_ptr<ILevel>& level) { return *level; }
+const ILevel& as_level(const std::unique_ptr<ILevel>& level) { return *level; }
+
+template <typename Level>
+Level& as_level(Level& level) {
+  return level;
+}
+
+}  // namespace
+
+void render_level(const TerminalLevel& level, std::ostream& out,
+                  const adventure::context::GameContext& context) {
+  std::visit([&](const auto& alternative) { as_level(alternative).render(out, context); }, level);
+}
+
+void execute_level(TerminalLevel& level, std::istream& in, std::ostream& out,
+                   adventure::context::GameContext& context) {
+  std::visit([&](auto& alternative) { as_level(alternative).execute(in, out, context); }, level);
+}
+
+}  // namespace adventure::levels
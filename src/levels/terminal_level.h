@@ -0,0 +1,29 @@
+#ifndef CLI_ADVENTURE_LEVELS_TERMINAL_LEVEL_H_
+#define CLI_ADVENTURE_LEVELS_TERMINAL_LEVEL_H_
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <variant>
+
+#include "context/game_context.h"
+#include "levels/choice_level.h"
+#include "levels/end_game_level.h"
+#include "levels/ilevel.h"
+#include "levels/input_level.h"
+
+namespace adventure::levels {
+
+// A level held by value. The built-in kinds live inline and are called directly (their classes
+// are final); level types added outside this set implement ILevel and use the last alternative.
+using TerminalLevel =
+    std::variant<ChoiceLevel, InputLevel, EndGameLevel, std::unique_ptr<ILevel>>;
+
+void render_level(const TerminalLevel& level, std::ostream& out,
+                  const adventure::context::GameContext& context);
+void execute_level(TerminalLevel& level, std::istream& in, std::ostream& out,
+                   adventure::context::GameContext& context);
+
+}  // namespace adventure::levels
+
+#endif  // CLI_ADVENTURE_LEVELS_TERMINAL_LEVEL_H_
@@ -1,8 +1,11 @@
 #include "levels/terminal_level_factory.h"
 
+#include <utility>
+
 #include "levels/choice_level.h"
 #include "levels/end_game_level.h"
 #include "levels/input_level.h"
+#include "parser/tag_parser.h"
 
 namespace adventure::levels {
 
@@ -10,20 +13,28 @@ TerminalLevelFactory::TerminalLevelFactory(const adventure::ui::Renderer& render
     : renderer_(renderer) {}
 
 std::unique_ptr<ILevel> TerminalLevelFactory::create(
-    const adventure::parser::ParsedLevelData& data) const {
-  const auto mode_it = data.directives.find("input_mode");
-  if (mode_it != data.directives.end() && mode_it->second == "endgame") {
-    return std::make_unique<EndGameLevel>(data, renderer_);
-  }
-  if (mode_it != data.directives.end() && mode_it->second == "input") {
-    return std::make_unique<InputLevel>(data, renderer_);
+    adventure::parser::ParsedLevelData data) const {
+  switch (adventure::parser::input_mode_of(data)) {
+    case adventure::parser::InputMode::kEndGame:
+      return std::make_unique<EndGameLevel>(std::move(data), renderer_);
+    case adventure::parser::InputMode::kInput:
+      return std::make_unique<InputLevel>(std::move(data), renderer_);
+    case adventure::parser::InputMode::kChoice:
+      break;
   }
+  return std::make_unique<ChoiceLevel>(std::move(data), renderer_);
+}
 
-  if (mode_it == data.directives.end() || mode_it->second == "choice") {
-    return std::make_unique<ChoiceLevel>(data, renderer_);
+TerminalLevel TerminalLevelFactory::create_inline(adventure::parser::ParsedLevelData data) const {
+  switch (adventure::parser::input_mode_of(data)) {
+    case adventure::parser::InputMode::kEndGame:
+      return TerminalLevel(std::in_place_type<EndGameLevel>, std::move(data), renderer_);
+    case adventure::parser::InputMode::kInput:
+      return TerminalLevel(std::in_place_type<InputLevel>, std::move(data), renderer_);
+    case adventure::parser::InputMode::kChoice:
+      break;
   }
-
-  return std::make_unique<ChoiceLevel>(data, renderer_);
+  return TerminalLevel(std::in_place_type<ChoiceLevel>, std::move(data), renderer_);
 }
 
 }  // namespace adventure::levels
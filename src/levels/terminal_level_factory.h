@@ -4,6 +4,7 @@
 #include <memory>
 
 #include "levels/ilevel.h"
+#include "levels/terminal_level.h"
 #include "parser/parsed_level.h"
 #include "ui/renderer.h"
 
@@ -13,7 +14,11 @@ class TerminalLevelFactory {
  public:
   explicit TerminalLevelFactory(const adventure::ui::Renderer& renderer);
 
-  std::unique_ptr<ILevel> create(const adventure::parser::ParsedLevelData& data) const;
+  // Levels take ownership of the parsed data; pass an rvalue (std::move or a fresh parse) to
+  // avoid copying its strings and containers. `input_mode` picks the level kind once, here.
+  std::unique_ptr<ILevel> create(adventure::parser::ParsedLevelData data) const;
+  // Same level kinds, built in place without a heap allocation for the level object.
+  TerminalLevel create_inline(adventure::parser::ParsedLevelData data) const;
 
  private:
   const adventure::ui::Renderer& renderer_;
@@ -1,21 +1,37 @@
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
 #include <string>
 #include <vector>
 
+#include "catalog/game_catalog.h"
+#include "cli/batch_commands.h"
 #include "context/game_context.h"
 #include "engine/engine.h"
+#include "ui/latency_recorder.h"
 #include "ui/renderer.h"
 #include "ui/terminal_menu.h"
 #include "ui/theme.h"
 #include "validation/game_validator.h"
+#include "validation/state_explorer.h"
 
 namespace {
 
+enum class CliMode {
+  kInteractive,
+  kValidate,
+  kPlay,
+  kBench,
+  kFootprint,
+};
+
 struct CliOptions {
+  CliMode mode = CliMode::kInteractive;
   std::filesystem::path games_root = "games";
   std::filesystem::path theme_file = "themes/default.theme";
+  std::filesystem::path game;    // batch modes
+  std::filesystem::path script;  // --play
 };
 
 int print_usage(const char* program_name) {
@@ -25,10 +41,40 @@ int print_usage(const char* program_name) {
   std::cerr << "Example: " << program_name << "\n";
   std::cerr << "Example: " << program_name << " ./games\n";
   std::cerr << "Example: " << program_name << " ./games --theme ./themes/default.theme\n";
-  return 1;
+  std::cerr << "\nNon-interactive:\n";
+  std::cerr << "  " << program_name << " --validate <game>   (JSON report; exit 1 on issues)\n";
+  std::cerr << "  " << program_name << " --play <game> --script <file>   (headless playthrough)\n";
+  std::cerr << "  " << program_name << " --bench <game>   (time load/parse/render per level)\n";
+  std::cerr << "  " << program_name << " --footprint <game>   (JSON memory footprint report)\n";
+  return adventure::cli::kExitUsage;
+}
+
+bool parse_batch_args(int argc, char** argv, CliOptions* options) {
+  const std::string command = argv[1];
+  if (command == "--validate" && argc == 3) {
+    options->mode = CliMode::kValidate;
+  } else if (command == "--bench" && argc == 3) {
+    options->mode = CliMode::kBench;
+  } else if (command == "--footprint" && argc == 3) {
+    options->mode = CliMode::kFootprint;
+  } else if (command == "--play" && argc == 5 && std::string(argv[3]) == "--script") {
+    options->mode = CliMode::kPlay;
+    options->script = argv[4];
+  } else {
+    return false;
+  }
+  options->game = std::filesystem::path(argv[2]).lexically_normal();
+  return true;
 }
 
 bool parse_args(int argc, char** argv, CliOptions* options) {
+  if (argc > 1) {
+    const std::string first = argv[1];
+    if (first == "--validate" || first == "--play" || first == "--bench" ||
+        first == "--footprint") {
+      return parse_batch_args(argc, argv, options);
+    }
+  }
   if (argc == 1) {
     return true;
   }
@@ -57,24 +103,36 @@ bool parse_args(int argc, char** argv, CliOptions* options) {
   return false;
 }
 
-std::vector<std::filesystem::path> discover_games(const std::filesystem::path& games_root) {
-  std::vector<std::filesystem::path> games;
-  for (const auto& entry : std::filesystem::directory_iterator(games_root)) {
-    if (!entry.is_directory()) {
-      continue;
-    }
-    const std::filesystem::path candidate_root = entry.path();
-    const std::filesystem::path start_file = candidate_root / "start.level";
-    if (std::filesystem::exists(start_file) && std::filesystem::is_regular_file(start_file)) {
-      games.push_back(candidate_root.lexically_normal());
-    }
+// Menu label for a catalog entry; the type-ahead filter matches title, author and folder.
+std::string game_label(const adventure::catalog::CatalogEntry& game) {
+  std::string label = game.title;
+  if (!game.author.empty()) {
+    label += " by " + game.author;
+  }
+  label += " (" + std::to_string(game.level_count) + " levels";
+  if (game.title != game.root.filename().string()) {
+    label += ", " + game.root.filename().string();
+  }
+  return label + ")";
+}
+
+// Refreshes the catalog and lets the player pick a game; returns nullptr on "Back".
+const adventure::catalog::CatalogEntry* pick_game(adventure::catalog::GameCatalog* catalog,
+                                                  const std::string& prompt,
+                                                  const adventure::ui::CompiledTheme& theme) {
+  catalog->refresh();
+  const std::vector<adventure::catalog::CatalogEntry>& games = catalog->games();
+  std::vector<std::string> game_names;
+  game_names.reserve(games.size() + 1);
+  for (const auto& game : games) {
+    game_names.push_back(game_label(game));
   }
+  game_names.push_back("Back");
 
-  std::sort(games.begin(), games.end(),
-            [](const std::filesystem::path& left, const std::filesystem::path& right) {
-              return left.filename().string() < right.filename().string();
-            });
-  return games;
+  const adventure::ui::MenuSelection selection =
+      adventure::ui::pick_option(std::cin, std::cout, game_names, prompt, theme);
+  adventure::ui::clear_menu_block(std::cin, std::cout, selection.rendered_lines);
+  return selection.index == games.size() ? nullptr : &games[selection.index];
 }
 
 std::vector<std::filesystem::path> discover_theme_files(const std::filesystem::path& theme_root) {
@@ -108,8 +166,11 @@ void run_session(const std::filesystem::path& game_root, const adventure::ui::Th
   context.set_current_directory(game_root.string());
   context.set_current_level_path(entry_level.string());
 
+  adventure::ui::LatencyRecorder& latency = adventure::ui::latency_recorder();
+  latency.begin_session(game_root.filename().string());
   adventure::engine::Engine engine{adventure::ui::Renderer(theme)};
   engine.run(std::cin, std::cout, context);
+  latency.end_session();
 }
 
 void run_validation(const std::filesystem::path& game_root, const adventure::ui::Theme& theme) {
@@ -117,7 +178,8 @@ void run_validation(const std::filesystem::path& game_root, const adventure::ui:
       adventure::validation::validate_game(game_root);
 
   std::vector<std::string> lines;
-  lines.push_back("Checked files: " + std::to_string(report.checked_files));
+  lines.push_back("Checked files: " + std::to_string(report.checked_files) + " (" +
+                  std::to_string(report.rechecked_files) + " changed since last validation)");
   if (report.issues.empty()) {
     lines.push_back("No issues found.");
   } else {
@@ -127,10 +189,58 @@ void run_validation(const std::filesystem::path& game_root, const adventure::ui:
     }
   }
 
+  const adventure::validation::ExplorationReport exploration =
+      adventure::validation::explore_game(game_root);
+  lines.push_back("");
+  lines.push_back("Explored states: " + std::to_string(exploration.states_explored) + " in " +
+                  std::to_string(static_cast<long long>(exploration.seconds * 1000.0)) +
+                  " ms (" + std::to_string(static_cast<long long>(exploration.states_per_second)) +
+                  " states/s)");
+  if (exploration.victory_reachable) {
+    lines.push_back("Shortest winning path (" +
+                    std::to_string(exploration.winning_path.size() - 1) + " moves):");
+    for (const auto& step : exploration.winning_path) {
+      std::string line = "  " + step.level.lexically_relative(game_root).string();
+      if (!step.choice.empty()) {
+        line += " [" + step.choice + "]";
+      }
+      lines.push_back(line);
+    }
+  } else if (exploration.truncated) {
+    lines.push_back("State limit reached before a victory was found.");
+  } else {
+    lines.push_back("No victory is reachable once memory conditions are applied.");
+  }
+
   adventure::ui::Renderer renderer(theme);
   renderer.render_scene(std::cout, "Validation: " + game_root.filename().string(), lines, "", "");
 }
 
+int run_batch(const CliOptions& options) {
+  const std::filesystem::path start_file = options.game / "start.level";
+  if (!std::filesystem::is_regular_file(start_file)) {
+    std::cerr << "Not a game directory (missing start.level): " << options.game.string() << "\n";
+    return adventure::cli::kExitUsage;
+  }
+
+  if (options.mode == CliMode::kValidate) {
+    return adventure::cli::run_validate_command(options.game, std::cout);
+  }
+  if (options.mode == CliMode::kBench) {
+    return adventure::cli::run_bench_command(options.game, std::cout);
+  }
+  if (options.mode == CliMode::kFootprint) {
+    return adventure::cli::run_footprint_command(options.game, std::cout);
+  }
+
+  std::ifstream script(options.script);
+  if (!script.is_open()) {
+    std::cerr << "Could not open script file: " << options.script.string() << "\n";
+    return adventure::cli::kExitUsage;
+  }
+  return adventure::cli::run_play_command(options.game, script, std::cout);
+}
+
 }  // namespace
 
 int main(int argc, char** argv) {
@@ -138,6 +248,9 @@ int main(int argc, char** argv) {
   if (!parse_args(argc, argv, &options)) {
     return print_usage(argv[0]);
   }
+  if (options.mode != CliMode::kInteractive) {
+    return run_batch(options);
+  }
 
   if (!std::filesystem::exists(options.games_root) ||
       !std::filesystem::is_directory(options.games_root)) {
@@ -146,36 +259,34 @@ int main(int argc, char** argv) {
     return 1;
   }
 
-  if (discover_games(options.games_root).empty()) {
+  adventure::catalog::GameCatalog catalog(
+      options.games_root, adventure::catalog::default_catalog_index_path(options.games_root));
+  catalog.refresh();
+  if (catalog.games().empty()) {
     std::cerr << "No playable games found in: " << options.games_root.string()
               << " (each game must contain start.level)\n";
     return 1;
   }
 
+  std::filesystem::path loaded_theme_file;
+  adventure::ui::Theme theme;
+  adventure::ui::CompiledTheme menu_theme;
   while (true) {
-    adventure::ui::Theme theme = load_runtime_theme(options.theme_file);
+    if (loaded_theme_file.empty() || loaded_theme_file != options.theme_file) {
+      theme = load_runtime_theme(options.theme_file);
+      menu_theme = adventure::ui::compile_theme(theme, adventure::ui::detect_color_depth());
+      loaded_theme_file = options.theme_file;
+    }
     const std::vector<std::string> main_options = {"Play Game", "Settings", "Validate Games", "Exit"};
 
     const adventure::ui::MenuSelection main_selection = adventure::ui::pick_option(
-        std::cin, std::cout, main_options, "Main Menu", theme);
+        std::cin, std::cout, main_options, "Main Menu", menu_theme);
     adventure::ui::clear_menu_block(std::cin, std::cout, main_selection.rendered_lines);
 
     if (main_selection.index == 0) {
-      const std::vector<std::filesystem::path> games = discover_games(options.games_root);
-      std::vector<std::string> game_names;
-      game_names.reserve(games.size());
-      for (const auto& game_path : games) {
-        game_names.push_back(game_path.filename().string());
+      if (const auto* game = pick_game(&catalog, "Choose a game:", menu_theme)) {
+        run_session(game->root, theme);
       }
-      game_names.push_back("Back");
-
-      const adventure::ui::MenuSelection game_selection = adventure::ui::pick_option(
-          std::cin, std::cout, game_names, "Choose a game:", theme);
-      adventure::ui::clear_menu_block(std::cin, std::cout, game_selection.rendered_lines);
-      if (game_selection.index == games.size()) {
-        continue;
-      }
-      run_session(games[game_selection.index], theme);
       continue;
     }
 
@@ -197,7 +308,7 @@ int main(int argc, char** argv) {
       }
       theme_names.push_back("Back");
       const adventure::ui::MenuSelection theme_selection = adventure::ui::pick_option(
-          std::cin, std::cout, theme_names, "Choose theme:", theme);
+          std::cin, std::cout, theme_names, "Choose theme:", menu_theme);
       adventure::ui::clear_menu_block(std::cin, std::cout, theme_selection.rendered_lines);
       if (theme_selection.index == theme_files.size()) {
         continue;
@@ -207,20 +318,9 @@ int main(int argc, char** argv) {
     }
 
     if (main_selection.index == 2) {
-      const std::vector<std::filesystem::path> games = discover_games(options.games_root);
-      std::vector<std::string> game_names;
-      game_names.reserve(games.size());
-      for (const auto& game_path : games) {
-        game_names.push_back(game_path.filename().string());
-      }
-      game_names.push_back("Back");
-      const adventure::ui::MenuSelection game_selection = adventure::ui::pick_option(
-          std::cin, std::cout, game_names, "Validate which game?", theme);
-      adventure::ui::clear_menu_block(std::cin, std::cout, game_selection.rendered_lines);
-      if (game_selection.index == games.size()) {
-        continue;
+      if (const auto* game = pick_game(&catalog, "Validate which game?", menu_theme)) {
+        run_validation(game->root, theme);
       }
-      run_validation(games[game_selection.index], theme);
       continue;
     }
 
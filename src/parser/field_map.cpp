@@ -0,0 +1,49 @@
+#include "parser/field_map.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace adventure::parser {
+namespace {
+
+bool key_less(const FieldMap::value_type& entry, std::string_view key) {
+  return std::string_view(entry.first) < key;
+}
+
+}  // namespace
+
+FieldMap::iterator FieldMap::lower_bound(std::string_view key) {
+  return std::lower_bound(entries_.begin(), entries_.end(), key, key_less);
+}
+
+FieldMap::iterator FieldMap::find(std::string_view key) {
+  const iterator it = lower_bound(key);
+  return it != entries_.end() && it->first == key ? it : entries_.end();
+}
+
+FieldMap::const_iterator FieldMap::find(std::string_view key) const {
+  const const_iterator it = std::lower_bound(entries_.begin(), entries_.end(), key, key_less);
+  return it != entries_.end() && it->first == key ? it : entries_.end();
+}
+
+const std::string& FieldMap::at(std::string_view key) const {
+  const const_iterator it = find(key);
+  if (it == entries_.end()) {
+    throw std::out_of_range("FieldMap has no key `" + std::string(key) + "`.");
+  }
+  return it->second;
+}
+
+std::string& FieldMap::operator[](std::string_view key) {
+  iterator it = lower_bound(key);
+  if (it == entries_.end() || it->first != key) {
+    it = entries_.emplace(it, std::string(key), std::string());
+  }
+  return it->second;
+}
+
+void FieldMap::insert_or_assign(std::string_view key, std::string value) {
+  (*this)[key] = std::move(value);
+}
+
+}  // namespace adventure::parser
@@ -0,0 +1,50 @@
+#ifndef CLI_ADVENTURE_PARSER_FIELD_MAP_H_
+#define CLI_ADVENTURE_PARSER_FIELD_MAP_H_
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace adventure::parser {
+
+// `key: value` fields of a [HEADER] or [DIRECTIVES] section. Levels carry a handful of these, so
+// they are kept as one vector sorted by key: a lookup is a short binary search over contiguous
+// entries and the whole map is a single allocation.
+class FieldMap {
+ public:
+  using value_type = std::pair<std::string, std::string>;
+  using iterator = std::vector<value_type>::iterator;
+  using const_iterator = std::vector<value_type>::const_iterator;
+
+  FieldMap() = default;
+
+  iterator begin() { return entries_.begin(); }
+  iterator end() { return entries_.end(); }
+  const_iterator begin() const { return entries_.begin(); }
+  const_iterator end() const { return entries_.end(); }
+
+  std::size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+  std::size_t capacity() const { return entries_.capacity(); }
+
+  iterator find(std::string_view key);
+  const_iterator find(std::string_view key) const;
+  std::size_t count(std::string_view key) const { return find(key) == end() ? 0 : 1; }
+  // Throws std::out_of_range when `key` is absent.
+  const std::string& at(std::string_view key) const;
+
+  // Value for `key`, inserted empty when absent.
+  std::string& operator[](std::string_view key);
+  void insert_or_assign(std::string_view key, std::string value);
+
+ private:
+  iterator lower_bound(std::string_view key);
+
+  std::vector<value_type> entries_;
+};
+
+}  // namespace adventure::parser
+
+#endif  // CLI_ADVENTURE_PARSER_FIELD_MAP_H_
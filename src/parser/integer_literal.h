@@ -0,0 +1,29 @@
+#ifndef CLI_ADVENTURE_PARSER_INTEGER_LITERAL_H_
+#define CLI_ADVENTURE_PARSER_INTEGER_LITERAL_H_
+
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+
+namespace adventure::parser {
+
+// True when the whole of `text` is a base-10 int64 such as `10` or `-3`. Memory values written
+// this way are numbers; anything else, such as `+3` or `ten`, stays text.
+inline bool parse_integer(std::string_view text, std::int64_t* value) {
+  if (text.empty()) {
+    return false;
+  }
+  const char* end = text.data() + text.size();
+  std::int64_t parsed = 0;
+  const auto [last, error] = std::from_chars(text.data(), end, parsed);
+  if (error != std::errc() || last != end) {
+    return false;
+  }
+  *value = parsed;
+  return true;
+}
+
+}  // namespace adventure::parser
+
+#endif  // CLI_ADVENTURE_PARSER_INTEGER_LITERAL_H_
@@ -0,0 +1,109 @@
+#ifndef CLI_ADVENTURE_PARSER_KEYWORD_TABLE_H_
+#define CLI_ADVENTURE_PARSER_KEYWORD_TABLE_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+namespace adventure::parser {
+
+constexpr char ascii_lower(char ch) {
+  return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+constexpr bool equals_ignore_case(std::string_view left, std::string_view right) {
+  if (left.size() != right.size()) {
+    return false;
+  }
+  for (std::size_t i = 0; i < left.size(); ++i) {
+    if (ascii_lower(left[i]) != ascii_lower(right[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// FNV-1a over ASCII-lowercased bytes, so differently cased spellings hash alike.
+constexpr std::uint32_t keyword_hash(std::string_view text, std::uint32_t seed) {
+  std::uint32_t hash = 2166136261u ^ seed;
+  for (const char ch : text) {
+    hash ^= static_cast<unsigned char>(ascii_lower(ch));
+    hash *= 16777619u;
+  }
+  return hash ^ (hash >> 15);
+}
+
+template <typename Value>
+struct Keyword {
+  std::string_view name;
+  Value value;
+};
+
+// Fixed keyword set resolved with a perfect hash chosen at compile time: a lookup is one
+// case-insensitive hash, one slot load and one case-insensitive compare, with no allocation.
+template <typename Value, std::size_t N>
+class KeywordTable {
+ public:
+  constexpr explicit KeywordTable(const Keyword<Value> (&entries)[N]) {
+    for (std::size_t i = 0; i < N; ++i) {
+      entries_[i] = entries[i];
+    }
+    for (std::uint32_t seed = 0; seed < kMaxSeeds; ++seed) {
+      if (try_seed(seed)) {
+        seed_ = seed;
+        return;
+      }
+    }
+    throw std::logic_error("No collision-free seed for keyword table (duplicate keyword?).");
+  }
+
+  // Value for `key`, or nullptr when it is not a keyword.
+  constexpr const Value* find(std::string_view key) const {
+    const std::uint8_t slot = slots_[keyword_hash(key, seed_) & (kSlots - 1)];
+    if (slot == 0 || !equals_ignore_case(entries_[slot - 1].name, key)) {
+      return nullptr;
+    }
+    return &entries_[slot - 1].value;
+  }
+
+ private:
+  static constexpr std::size_t slot_count() {
+    std::size_t slots = 1;
+    while (slots < 2 * N) {
+      slots *= 2;
+    }
+    return slots;
+  }
+
+  static constexpr std::size_t kSlots = slot_count();
+  static constexpr std::uint32_t kMaxSeeds = 1u << 16;
+  static_assert(N < 255, "Slots store entry indices in one byte.");
+
+  constexpr bool try_seed(std::uint32_t seed) {
+    slots_ = {};
+    for (std::size_t i = 0; i < N; ++i) {
+      std::uint8_t& slot = slots_[keyword_hash(entries_[i].name, seed) & (kSlots - 1)];
+      if (slot != 0) {
+        return false;
+      }
+      slot = static_cast<std::uint8_t>(i + 1);
+    }
+    return true;
+  }
+
+  std::array<Keyword<Value>, N> entries_{};
+  std::array<std::uint8_t, kSlots> slots_{};  // entry index + 1; 0 marks an empty slot
+  std::uint32_t seed_ = 0;
+};
+
+// Usage: `constexpr auto kTable = make_keyword_table<Kind>({{"name", Kind::kName}, ...});`
+template <typename Value, std::size_t N>
+constexpr KeywordTable<Value, N> make_keyword_table(const Keyword<Value> (&entries)[N]) {
+  return KeywordTable<Value, N>(entries);
+}
+
+}  // namespace adventure::parser
+
+#endif  // CLI_ADVENTURE_PARSER_KEYWORD_TABLE_H_
@@ -1,11 +1,15 @@
 #ifndef CLI_ADVENTURE_PARSER_PARSED_LEVEL_H_
 #define CLI_ADVENTURE_PARSER_PARSED_LEVEL_H_
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "parser/field_map.h"
+#include "parser/text_lines.h"
+
 namespace adventure::parser {
 
 struct LevelOption {
@@ -26,11 +30,21 @@ struct MemoryMutation {
     kClearFlag,
     kSetValue,
     kEraseValue,
+    kSetNumber,  // set_value with a whole-number value
+    kAddNumber,  // add_value / sub_value; sub_value stores the negated amount
   };
 
   Kind kind;
   std::string key;
   std::string value;
+  std::int64_t number = 0;  // kSetNumber and kAddNumber
+};
+
+// requires_at_least=key:N or requires_at_most=key:N.
+struct NumberBound {
+  std::string key;
+  std::int64_t bound = 0;
+  bool at_most = false;
 };
 
 struct OptionCondition {
@@ -39,6 +53,8 @@ struct OptionCondition {
   std::vector<std::string> forbidden_flags;
   std::vector<std::pair<std::string, std::string>> required_values;
   std::vector<std::string> required_missing_values;
+  std::vector<NumberBound> number_bounds;
+  std::string expression;  // text after `when`; see conditions::compile_expression
 };
 
 struct OptionEffect {
@@ -46,12 +62,36 @@ struct OptionEffect {
   std::vector<MemoryMutation> mutations;
 };
 
+// Byte range of one [CONTENT] section in the level file: from the line after the section tag up
+// to the next tag or the end of the file.
+struct ContentRange {
+  std::uint64_t offset = 0;
+  std::uint64_t length = 0;
+};
+
+// Content too long to keep in memory. The parser leaves it in the file and records where it is;
+// the renderer pages it from there.
+struct StreamedContent {
+  std::string path;
+  std::vector<ContentRange> ranges;
+  std::size_t line_count = 0;
+
+  bool empty() const { return ranges.empty(); }
+};
+
+// Moves the value for `key` out of a header or directive map; empty when the key is absent.
+inline std::string take_field(FieldMap* fields, std::string_view key) {
+  const auto it = fields->find(key);
+  return it == fields->end() ? std::string() : std::move(it->second);
+}
+
 struct ParsedLevelData {
-  std::unordered_map<std::string, std::string> header;
-  std::vector<std::string> content_lines;
+  FieldMap header;
+  TextLines content_lines;  // empty when the content is streamed
+  StreamedContent streamed_content;
   std::vector<LevelOption> options;
   std::vector<InputRule> input_rules;
-  std::unordered_map<std::string, std::string> directives;
+  FieldMap directives;
   std::vector<MemoryMutation> on_enter_memory;
   std::vector<OptionCondition> option_conditions;
   std::vector<OptionEffect> option_effects;
@@ -2,13 +2,17 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <fstream>
-#include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "parser/integer_literal.h"
+#include "parser/keyword_table.h"
+
 namespace adventure::parser {
 namespace {
 
@@ -37,55 +41,79 @@ std::string trim(std::string value) {
   return std::string(first, last);
 }
 
-std::string to_upper(std::string value) {
-  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
-    return static_cast<char>(std::toupper(ch));
-  });
-  return value;
+std::string_view trim_view(std::string_view value) {
+  std::size_t first = 0;
+  while (first < value.size() && std::isspace(static_cast<unsigned char>(value[first])) != 0) {
+    ++first;
+  }
+  std::size_t last = value.size();
+  while (last > first && std::isspace(static_cast<unsigned char>(value[last - 1])) != 0) {
+    --last;
+  }
+  return value.substr(first, last - first);
 }
 
-std::string to_lower(std::string value) {
-  std::transform(value.begin(), value.end(), value.begin(), [](unsigned char ch) {
-    return static_cast<char>(std::tolower(ch));
-  });
-  return value;
-}
+enum class ConditionKeyword {
+  kOption,
+  kRequiresFlag,
+  kForbidsFlag,
+  kRequiresValue,
+  kRequiresMissingValue,
+  kRequiresAtLeast,
+  kRequiresAtMost,
+};
 
-bool is_section_tag(const std::string& line, std::string* section_name) {
-  const std::string candidate = trim(line);
+// Section names and line keywords are case-insensitive.
+constexpr auto kSections = make_keyword_table<Section>({
+    {"HEADER", Section::kHeader},
+    {"CONTENT", Section::kContent},
+    {"OPTIONS", Section::kOptions},
+    {"INPUT_RULES", Section::kInputRules},
+    {"DIRECTIVES", Section::kDirectives},
+    {"MEMORY", Section::kMemory},
+    {"OPTION_CONDITIONS", Section::kOptionConditions},
+    {"OPTION_EFFECTS", Section::kOptionEffects},
+});
+
+// sub_value is add_value with the amount negated.
+constexpr auto kMutationKeywords = make_keyword_table<MemoryMutation::Kind>({
+    {"add_flag", MemoryMutation::Kind::kAddFlag},
+    {"clear_flag", MemoryMutation::Kind::kClearFlag},
+    {"set_value", MemoryMutation::Kind::kSetValue},
+    {"erase_value", MemoryMutation::Kind::kEraseValue},
+    {"add_value", MemoryMutation::Kind::kAddNumber},
+    {"sub_value", MemoryMutation::Kind::kAddNumber},
+});
+
+constexpr auto kConditionKeywords = make_keyword_table<ConditionKeyword>({
+    {"option", ConditionKeyword::kOption},
+    {"requires_flag", ConditionKeyword::kRequiresFlag},
+    {"forbids_flag", ConditionKeyword::kForbidsFlag},
+    {"requires_value", ConditionKeyword::kRequiresValue},
+    {"requires_missing_value", ConditionKeyword::kRequiresMissingValue},
+    {"requires_at_least", ConditionKeyword::kRequiresAtLeast},
+    {"requires_at_most", ConditionKeyword::kRequiresAtMost},
+});
+
+constexpr auto kInputModes = make_keyword_table<InputMode>({
+    {"choice", InputMode::kChoice},
+    {"input", InputMode::kInput},
+    {"endgame", InputMode::kEndGame},
+});
+
+// A `[NAME]` line; unknown names give Section::kNone so their lines are skipped.
+bool is_section_tag(std::string_view line, Section* section) {
+  const std::string_view candidate = trim_view(line);
   if (candidate.size() < 3 || candidate.front() != '[' || candidate.back() != ']') {
     return false;
   }
-  *section_name = to_upper(trim(candidate.substr(1, candidate.size() - 2)));
-  return !section_name->empty();
-}
-
-Section section_from_name(const std::string& section_name) {
-  if (section_name == "HEADER") {
-    return Section::kHeader;
-  }
-  if (section_name == "CONTENT") {
-    return Section::kContent;
-  }
-  if (section_name == "OPTIONS") {
-    return Section::kOptions;
-  }
-  if (section_name == "INPUT_RULES") {
-    return Section::kInputRules;
-  }
-  if (section_name == "DIRECTIVES") {
-    return Section::kDirectives;
-  }
-  if (section_name == "MEMORY") {
-    return Section::kMemory;
-  }
-  if (section_name == "OPTION_CONDITIONS") {
-    return Section::kOptionConditions;
-  }
-  if (section_name == "OPTION_EFFECTS") {
-    return Section::kOptionEffects;
+  const std::string_view name = trim_view(candidate.substr(1, candidate.size() - 2));
+  if (name.empty()) {
+    return false;
   }
-  return Section::kNone;
+  const Section* found = kSections.find(name);
+  *section = found != nullptr ? *found : Section::kNone;
+  return true;
 }
 
 bool split_kv(const std::string& line, char delimiter, std::string* left, std::string* right) {
@@ -131,11 +159,19 @@ bool split_option(const std::string& line, std::string* id, std::string* text, s
 }
 
 std::vector<std::string> split_tokens(const std::string& line) {
-  std::istringstream in(line);
   std::vector<std::string> tokens;
-  std::string token;
-  while (in >> token) {
-    tokens.push_back(token);
+  std::size_t pos = 0;
+  while (pos < line.size()) {
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos])) != 0) {
+      ++pos;
+    }
+    const std::size_t start = pos;
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos])) == 0) {
+      ++pos;
+    }
+    if (pos > start) {
+      tokens.emplace_back(line, start, pos - start);
+    }
   }
   return tokens;
 }
@@ -160,38 +196,41 @@ bool parse_colon_pair(const std::string& token, std::string* left, std::string*
   return !left->empty() && !right->empty();
 }
 
+// Numbers are parsed here, once per level load, so applying a mutation never reads text.
 bool parse_mutation_token(const std::string& key, const std::string& value,
                           adventure::parser::MemoryMutation* mutation) {
-  if (key == "add_flag") {
-    mutation->kind = adventure::parser::MemoryMutation::Kind::kAddFlag;
-    mutation->key = value;
-    mutation->value.clear();
-    return true;
+  const MemoryMutation::Kind* kind = kMutationKeywords.find(key);
+  if (kind == nullptr) {
+    return false;
   }
-  if (key == "clear_flag") {
-    mutation->kind = adventure::parser::MemoryMutation::Kind::kClearFlag;
+  mutation->number = 0;
+  if (*kind != MemoryMutation::Kind::kSetValue && *kind != MemoryMutation::Kind::kAddNumber) {
+    mutation->kind = *kind;
     mutation->key = value;
     mutation->value.clear();
     return true;
   }
-  if (key == "erase_value") {
-    mutation->kind = adventure::parser::MemoryMutation::Kind::kEraseValue;
-    mutation->key = value;
-    mutation->value.clear();
-    return true;
+
+  std::string memory_key;
+  std::string memory_value;
+  if (!parse_colon_pair(value, &memory_key, &memory_value)) {
+    return false;
   }
-  if (key == "set_value") {
-    std::string memory_key;
-    std::string memory_value;
-    if (!parse_colon_pair(value, &memory_key, &memory_value)) {
+  const bool is_number = parse_integer(memory_value, &mutation->number);
+  if (*kind == MemoryMutation::Kind::kSetValue) {
+    mutation->kind = is_number ? MemoryMutation::Kind::kSetNumber : MemoryMutation::Kind::kSetValue;
+  } else {
+    if (!is_number || mutation->number == INT64_MIN) {
       return false;
     }
-    mutation->kind = adventure::parser::MemoryMutation::Kind::kSetValue;
-    mutation->key = memory_key;
-    mutation->value = memory_value;
-    return true;
+    mutation->kind = MemoryMutation::Kind::kAddNumber;
+    if (equals_ignore_case(key, "sub_value")) {
+      mutation->number = -mutation->number;
+    }
   }
-  return false;
+  mutation->key = std::move(memory_key);
+  mutation->value = std::move(memory_value);
+  return true;
 }
 
 void parse_memory_line(const std::string& line,
@@ -200,7 +239,7 @@ void parse_memory_line(const std::string& line,
   bool is_on_enter = false;
 
   for (const std::string& token : tokens) {
-    if (to_upper(token) == "ON_ENTER") {
+    if (equals_ignore_case(token, "on_enter")) {
       is_on_enter = true;
       continue;
     }
@@ -210,16 +249,40 @@ void parse_memory_line(const std::string& line,
       continue;
     }
     adventure::parser::MemoryMutation mutation;
-    if (parse_mutation_token(to_lower(key), value, &mutation) && is_on_enter) {
+    if (parse_mutation_token(key, value, &mutation) && is_on_enter) {
       out->push_back(std::move(mutation));
     }
   }
 }
 
+// Start of the first whitespace-delimited word equal to `word` (ignoring case), or npos.
+std::size_t find_word(const std::string& line, std::string_view word) {
+  std::size_t pos = 0;
+  while (pos < line.size()) {
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos])) != 0) {
+      ++pos;
+    }
+    const std::size_t start = pos;
+    while (pos < line.size() && std::isspace(static_cast<unsigned char>(line[pos])) == 0) {
+      ++pos;
+    }
+    const std::string_view candidate(line.data() + start, pos - start);
+    if (!candidate.empty() && equals_ignore_case(candidate, word)) {
+      return start;
+    }
+  }
+  return std::string::npos;
+}
+
 void parse_option_condition_line(const std::string& line,
                                  std::vector<adventure::parser::OptionCondition>* out) {
-  const std::vector<std::string> tokens = split_tokens(line);
   adventure::parser::OptionCondition condition;
+  // Everything after a standalone `when` is one expression, spaces and all.
+  const std::size_t when = find_word(line, "when");
+  if (when != std::string::npos) {
+    condition.expression = std::string(trim_view(std::string_view(line).substr(when + 4)));
+  }
+  const std::vector<std::string> tokens = split_tokens(line.substr(0, when));
 
   for (const std::string& token : tokens) {
     std::string key;
@@ -227,21 +290,44 @@ void parse_option_condition_line(const std::string& line,
     if (!split_token_kv(token, &key, &value)) {
       continue;
     }
-    const std::string normalized_key = to_lower(key);
-    if (normalized_key == "option") {
-      condition.option_id = value;
-    } else if (normalized_key == "requires_flag") {
-      condition.required_flags.push_back(value);
-    } else if (normalized_key == "forbids_flag") {
-      condition.forbidden_flags.push_back(value);
-    } else if (normalized_key == "requires_value") {
-      std::string memory_key;
-      std::string memory_value;
-      if (parse_colon_pair(value, &memory_key, &memory_value)) {
-        condition.required_values.push_back({memory_key, memory_value});
+    const ConditionKeyword* keyword = kConditionKeywords.find(key);
+    if (keyword == nullptr) {
+      continue;
+    }
+    switch (*keyword) {
+      case ConditionKeyword::kOption:
+        condition.option_id = value;
+        break;
+      case ConditionKeyword::kRequiresFlag:
+        condition.required_flags.push_back(value);
+        break;
+      case ConditionKeyword::kForbidsFlag:
+        condition.forbidden_flags.push_back(value);
+        break;
+      case ConditionKeyword::kRequiresValue: {
+        std::string memory_key;
+        std::string memory_value;
+        if (parse_colon_pair(value, &memory_key, &memory_value)) {
+          condition.required_values.push_back({memory_key, memory_value});
+        }
+        break;
+      }
+      case ConditionKeyword::kRequiresMissingValue:
+        condition.required_missing_values.push_back(value);
+        break;
+      case ConditionKeyword::kRequiresAtLeast:
+      case ConditionKeyword::kRequiresAtMost: {
+        std::string memory_key;
+        std::string memory_value;
+        NumberBound bound;
+        if (parse_colon_pair(value, &memory_key, &memory_value) &&
+            parse_integer(memory_value, &bound.bound)) {
+          bound.key = std::move(memory_key);
+          bound.at_most = *keyword == ConditionKeyword::kRequiresAtMost;
+          condition.number_bounds.push_back(std::move(bound));
+        }
+        break;
       }
-    } else if (normalized_key == "requires_missing_value") {
-      condition.required_missing_values.push_back(value);
     }
   }
 
@@ -261,14 +347,13 @@ void parse_option_effect_line(const std::string& line,
     if (!split_token_kv(token, &key, &value)) {
       continue;
     }
-    const std::string normalized_key = to_lower(key);
-    if (normalized_key == "option") {
+    if (equals_ignore_case(key, "option")) {
       effect.option_id = value;
       continue;
     }
 
     adventure::parser::MemoryMutation mutation;
-    if (parse_mutation_token(normalized_key, value, &mutation)) {
+    if (parse_mutation_token(key, value, &mutation)) {
       effect.mutations.push_back(std::move(mutation));
     }
   }
@@ -280,37 +365,82 @@ void parse_option_effect_line(const std::string& line,
 
 }  // namespace
 
+InputMode input_mode_of(const ParsedLevelData& data) {
+  const auto mode_it = data.directives.find("input_mode");
+  if (mode_it == data.directives.end()) {
+    return InputMode::kChoice;
+  }
+  const InputMode* mode = kInputModes.find(mode_it->second);
+  return mode != nullptr ? *mode : InputMode::kChoice;
+}
+
+TagParser::TagParser(std::size_t stream_content_bytes)
+    : stream_content_bytes_(stream_content_bytes) {}
+
 ParsedLevelData TagParser::parse(std::istream& input) const {
+  return parse_stream(input, nullptr);
+}
+
+ParsedLevelData TagParser::parse_stream(std::istream& input,
+                                        const std::filesystem::path* source) const {
   ParsedLevelData data;
   Section section = Section::kNone;
+  StreamedContent& streamed = data.streamed_content;
+  std::uint64_t offset = 0;  // of the next line
+  std::uint64_t content_bytes = 0;
+  bool streaming = false;
 
   std::string raw_line;
   while (std::getline(input, raw_line)) {
-    std::string section_name;
-    if (is_section_tag(raw_line, &section_name)) {
-      section = section_from_name(section_name);
+    const std::uint64_t line_offset = offset;
+    offset += raw_line.size() + (input.eof() ? 0 : 1);
+
+    const Section previous = section;
+    if (is_section_tag(raw_line, &section)) {
+      if (previous == Section::kContent) {
+        streamed.ranges.back().length = line_offset - streamed.ranges.back().offset;
+      }
+      if (section == Section::kContent) {
+        streamed.ranges.push_back(ContentRange{offset, 0});
+      }
       continue;
     }
 
-    const std::string line = trim(raw_line);
-    if (line.empty()) {
+    if (section == Section::kContent) {
+      ++streamed.line_count;
+      content_bytes += raw_line.size() + 1;
+      if (source != nullptr && !streaming && content_bytes > stream_content_bytes_) {
+        streaming = true;
+        data.content_lines = TextLines();
+      }
+      if (streaming) {
+        continue;
+      }
+    }
+
+    const std::string_view trimmed = trim_view(raw_line);
+    if (trimmed.empty()) {
       if (section == Section::kContent) {
-        data.content_lines.emplace_back("");
+        data.content_lines.push_back("");
       }
       continue;
     }
+    if (section == Section::kContent) {
+      data.content_lines.push_back(raw_line);
+      continue;
+    }
+    const std::string line(trimmed);
 
     switch (section) {
       case Section::kHeader: {
         std::string key;
         std::string value;
         if (split_kv(line, ':', &key, &value)) {
-          data.header[key] = value;
+          data.header.insert_or_assign(key, std::move(value));
         }
         break;
       }
-      case Section::kContent:
-        data.content_lines.push_back(raw_line);
+      case Section::kContent:  // handled above, untrimmed
         break;
       case Section::kOptions: {
         std::string id;
@@ -334,7 +464,7 @@ ParsedLevelData TagParser::parse(std::istream& input) const {
         std::string key;
         std::string value;
         if (split_kv(line, ':', &key, &value)) {
-          data.directives[key] = value;
+          data.directives.insert_or_assign(key, std::move(value));
         }
         break;
       }
@@ -352,15 +482,23 @@ ParsedLevelData TagParser::parse(std::istream& input) const {
     }
   }
 
+  if (section == Section::kContent) {
+    streamed.ranges.back().length = offset - streamed.ranges.back().offset;
+  }
+  if (streaming) {
+    streamed.path = source->string();
+  } else {
+    streamed = StreamedContent();
+  }
   return data;
 }
 
 ParsedLevelData TagParser::parse_file(const std::filesystem::path& file_path) const {
-  std::ifstream file(file_path);
+  std::ifstream file(file_path, std::ios::binary);
   if (!file.is_open()) {
     throw std::runtime_error("Could not open level file: " + file_path.string());
   }
-  return parse(file);
+  return parse_stream(file, &file_path);
 }
 
 }  // namespace adventure::parser
@@ -1,6 +1,7 @@
 #ifndef CLI_ADVENTURE_PARSER_TAG_PARSER_H_
 #define CLI_ADVENTURE_PARSER_TAG_PARSER_H_
 
+#include <cstddef>
 #include <filesystem>
 #include <istream>
 
@@ -8,10 +9,32 @@
 
 namespace adventure::parser {
 
+enum class InputMode {
+  kChoice,
+  kInput,
+  kEndGame,
+};
+
+// The `input_mode` directive, matched case-insensitively. Missing or unknown modes are choice
+// levels, as the engine has always treated them.
+InputMode input_mode_of(const ParsedLevelData& data);
+
 class TagParser {
  public:
+  // parse_file leaves [CONTENT] longer than this in the file (see StreamedContent) instead of
+  // copying it into `content_lines`. parse() has no file to page from and always copies.
+  static constexpr std::size_t kDefaultStreamContentBytes = 64 * 1024;
+
+  TagParser() = default;
+  explicit TagParser(std::size_t stream_content_bytes);
+
   ParsedLevelData parse(std::istream& input) const;
   ParsedLevelData parse_file(const std::filesystem::path& file_path) const;
+
+ private:
+  ParsedLevelData parse_stream(std::istream& input, const std::filesystem::path* source) const;
+
+  std::size_t stream_content_bytes_ = kDefaultStreamContentBytes;
 };
 
 }  // namespace adventure::parser
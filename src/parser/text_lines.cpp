@@ -0,0 +1,27 @@
+#include "parser/text_lines.h"
+
+namespace adventure::parser {
+
+TextLines::TextLines(std::initializer_list<std::string_view> lines) {
+  std::size_t bytes = 0;
+  for (const std::string_view line : lines) {
+    bytes += line.size();
+  }
+  reserve(lines.size(), bytes);
+  for (const std::string_view line : lines) {
+    push_back(line);
+  }
+}
+
+void TextLines::push_back(std::string_view line) {
+  spans_.push_back(
+      Span{static_cast<std::uint32_t>(text_.size()), static_cast<std::uint32_t>(line.size())});
+  text_.append(line.data(), line.size());
+}
+
+void TextLines::reserve(std::size_t lines, std::size_t bytes) {
+  spans_.reserve(lines);
+  text_.reserve(bytes);
+}
+
+}  // namespace adventure::parser
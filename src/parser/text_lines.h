@@ -0,0 +1,73 @@
+#ifndef CLI_ADVENTURE_PARSER_TEXT_LINES_H_
+#define CLI_ADVENTURE_PARSER_TEXT_LINES_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace adventure::parser {
+
+// Lines of text stored back to back in one buffer, each addressed by an (offset, length) span.
+// A level's [CONTENT] costs two allocations however many lines it has, and rendering walks one
+// contiguous block instead of a string object per line.
+class TextLines {
+ public:
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::string_view*;
+    using reference = std::string_view;
+
+    const_iterator(const TextLines* lines, std::size_t index) : lines_(lines), index_(index) {}
+
+    std::string_view operator*() const { return (*lines_)[index_]; }
+    const_iterator& operator++() {
+      ++index_;
+      return *this;
+    }
+    bool operator==(const const_iterator& other) const { return index_ == other.index_; }
+    bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+   private:
+    const TextLines* lines_;
+    std::size_t index_;
+  };
+
+  TextLines() = default;
+  TextLines(std::initializer_list<std::string_view> lines);
+
+  void push_back(std::string_view line);
+  void reserve(std::size_t lines, std::size_t bytes);
+
+  std::size_t size() const { return spans_.size(); }
+  bool empty() const { return spans_.empty(); }
+  std::string_view operator[](std::size_t index) const {
+    return std::string_view(text_.data() + spans_[index].offset, spans_[index].length);
+  }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, spans_.size()); }
+
+  // Storage, for footprint accounting.
+  const std::string& text() const { return text_; }
+  std::size_t span_capacity() const { return spans_.capacity(); }
+  static constexpr std::size_t kSpanBytes = 2 * sizeof(std::uint32_t);
+
+ private:
+  struct Span {
+    std::uint32_t offset;
+    std::uint32_t length;
+  };
+
+  std::string text_;
+  std::vector<Span> spans_;
+};
+
+}  // namespace adventure::parser
+
+#endif  // CLI_ADVENTURE_PARSER_TEXT_LINES_H_
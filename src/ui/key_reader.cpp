@@ -0,0 +1,216 @@
+#include "ui/key_reader.h"
+
+#include <cerrno>
+
+#include <poll.h>
+#include <unistd.h>
+
+namespace adventure::ui {
+
+bool KeyDecoder::feed(unsigned char byte, KeyEvent* event) {
+  switch (state_) {
+    case State::kGround:
+      if (byte == 0x1b) {
+        state_ = State::kEscape;
+        return false;
+      }
+      return decode_ground(byte, false, event);
+
+    case State::kEscape:
+      if (byte == '[') {
+        state_ = State::kCsi;
+        first_param_ = 0;
+        in_first_param_ = true;
+        return false;
+      }
+      if (byte == 'O') {
+        state_ = State::kSs3;
+        return false;
+      }
+      if (byte == 0x1b) {
+        // ESC ESC: report the first one and keep waiting on the second.
+        *event = KeyEvent{KeyCode::kEscape, 0, false};
+        return true;
+      }
+      reset();
+      return decode_ground(byte, true, event);
+
+    case State::kCsi:
+      if (byte >= 0x30 && byte <= 0x3f) {
+        if (byte >= '0' && byte <= '9' && in_first_param_) {
+          first_param_ = first_param_ * 10 + (byte - '0');
+        } else {
+          in_first_param_ = false;
+        }
+        return false;
+      }
+      if (byte >= 0x20 && byte <= 0x2f) {
+        in_first_param_ = false;
+        return false;
+      }
+      *event = decode_csi_final(byte);
+      reset();
+      return true;
+
+    case State::kSs3:
+      *event = decode_ss3_final(byte);
+      reset();
+      return true;
+  }
+  return false;
+}
+
+bool KeyDecoder::pending() const { return state_ != State::kGround; }
+
+KeyEvent KeyDecoder::flush() {
+  const State state = state_;
+  reset();
+  if (state == State::kEscape) {
+    return KeyEvent{KeyCode::kEscape, 0, false};
+  }
+  return KeyEvent{KeyCode::kUnknown, 0, false};
+}
+
+bool KeyDecoder::decode_ground(unsigned char byte, bool alt, KeyEvent* event) {
+  event->alt = alt;
+  event->ch = 0;
+  if (byte == '\r' || byte == '\n') {
+    event->code = KeyCode::kEnter;
+  } else if (byte == '\t') {
+    event->code = KeyCode::kTab;
+  } else if (byte == 0x7f || byte == 0x08) {
+    event->code = KeyCode::kBackspace;
+  } else if (byte < 0x20) {
+    event->code = KeyCode::kUnknown;
+  } else {
+    event->code = KeyCode::kChar;
+    event->ch = static_cast<char>(byte);
+  }
+  return true;
+}
+
+KeyEvent KeyDecoder::decode_csi_final(unsigned char final_byte) const {
+  switch (final_byte) {
+    case 'A':
+      return KeyEvent{KeyCode::kUp, 0, false};
+    case 'B':
+      return KeyEvent{KeyCode::kDown, 0, false};
+    case 'C':
+      return KeyEvent{KeyCode::kRight, 0, false};
+    case 'D':
+      return KeyEvent{KeyCode::kLeft, 0, false};
+    case 'H':
+      return KeyEvent{KeyCode::kHome, 0, false};
+    case 'F':
+      return KeyEvent{KeyCode::kEnd, 0, false};
+    case '~':
+      switch (first_param_) {
+        case 1:
+        case 7:
+          return KeyEvent{KeyCode::kHome, 0, false};
+        case 2:
+          return KeyEvent{KeyCode::kInsert, 0, false};
+        case 3:
+          return KeyEvent{KeyCode::kDelete, 0, false};
+        case 4:
+        case 8:
+          return KeyEvent{KeyCode::kEnd, 0, false};
+        case 5:
+          return KeyEvent{KeyCode::kPageUp, 0, false};
+        case 6:
+          return KeyEvent{KeyCode::kPageDown, 0, false};
+        default:
+          return KeyEvent{KeyCode::kUnknown, 0, false};
+      }
+    default:
+      return KeyEvent{KeyCode::kUnknown, 0, false};
+  }
+}
+
+KeyEvent KeyDecoder::decode_ss3_final(unsigned char final_byte) {
+  switch (final_byte) {
+    case 'A':
+      return KeyEvent{KeyCode::kUp, 0, false};
+    case 'B':
+      return KeyEvent{KeyCode::kDown, 0, false};
+    case 'C':
+      return KeyEvent{KeyCode::kRight, 0, false};
+    case 'D':
+      return KeyEvent{KeyCode::kLeft, 0, false};
+    case 'H':
+      return KeyEvent{KeyCode::kHome, 0, false};
+    case 'F':
+      return KeyEvent{KeyCode::kEnd, 0, false};
+    case 'M':
+      return KeyEvent{KeyCode::kEnter, 0, false};
+    default:
+      return KeyEvent{KeyCode::kUnknown, 0, false};
+  }
+}
+
+void KeyDecoder::reset() {
+  state_ = State::kGround;
+  first_param_ = 0;
+  in_first_param_ = true;
+}
+
+KeyReader::KeyReader(int fd, int escape_timeout_ms)
+    : fd_(fd), escape_timeout_ms_(escape_timeout_ms) {}
+
+KeyEvent KeyReader::next() {
+  while (true) {
+    while (position_ < length_) {
+      KeyEvent event;
+      const unsigned char byte = static_cast<unsigned char>(buffer_[position_++]);
+      if (decoder_.feed(byte, &event)) {
+        return event;
+      }
+    }
+
+    // Mid-sequence, wait only briefly for the rest; otherwise block for the next key.
+    const FillResult result = fill(decoder_.pending() ? escape_timeout_ms_ : -1);
+    if (result == FillResult::kData) {
+      continue;
+    }
+    if (result == FillResult::kInterrupted) {
+      if (decoder_.pending()) {
+        continue;
+      }
+      return KeyEvent{KeyCode::kInterrupted, 0, false};
+    }
+    if (decoder_.pending()) {
+      return decoder_.flush();
+    }
+    if (result == FillResult::kEof) {
+      return KeyEvent{KeyCode::kEof, 0, false};
+    }
+  }
+}
+
+bool KeyReader::has_buffered_input() const { return position_ < length_; }
+
+KeyReader::FillResult KeyReader::fill(int timeout_ms) {
+  if (timeout_ms >= 0) {
+    pollfd descriptor{fd_, POLLIN, 0};
+    const int ready = poll(&descriptor, 1, timeout_ms);
+    if (ready == 0) {
+      return FillResult::kTimeout;
+    }
+    if (ready < 0) {
+      return errno == EINTR ? FillResult::kInterrupted : FillResult::kEof;
+    }
+  }
+
+  const ssize_t n = read(fd_, buffer_.data(), buffer_.size());
+  if (n < 0 && errno == EINTR) {
+    return FillResult::kInterrupted;
+  }
+  if (n <= 0) {
+    return FillResult::kEof;
+  }
+  position_ = 0;
+  length_ = static_cast<std::size_t>(n);
+  return FillResult::kData;
+}
+
+}  // namespace adventure::ui
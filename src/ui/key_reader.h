@@ -0,0 +1,94 @@
+#ifndef CLI_ADVENTURE_UI_KEY_READER_H_
+#define CLI_ADVENTURE_UI_KEY_READER_H_
+
+#include <array>
+#include <cstddef>
+
+namespace adventure::ui {
+
+enum class KeyCode {
+  kChar,
+  kEnter,
+  kTab,
+  kBackspace,
+  kEscape,
+  kUp,
+  kDown,
+  kLeft,
+  kRight,
+  kHome,
+  kEnd,
+  kPageUp,
+  kPageDown,
+  kInsert,
+  kDelete,
+  kUnknown,
+  kInterrupted,  // a signal interrupted the wait; the caller should check its signal flags
+  kEof,
+};
+
+struct KeyEvent {
+  KeyCode code = KeyCode::kUnknown;
+  char ch = 0;       // set for KeyCode::kChar
+  bool alt = false;  // key arrived prefixed by a lone ESC
+};
+
+// Byte-at-a-time decoder for terminal input. Understands CSI (`ESC [ ... final`) and SS3
+// (`ESC O final`) sequences of any length; an incomplete sequence is resolved by flush()
+// once the caller decides no more bytes are coming.
+class KeyDecoder {
+ public:
+  bool feed(unsigned char byte, KeyEvent* event);
+  bool pending() const;
+  KeyEvent flush();
+
+ private:
+  enum class State {
+    kGround,
+    kEscape,
+    kCsi,
+    kSs3,
+  };
+
+  bool decode_ground(unsigned char byte, bool alt, KeyEvent* event);
+  KeyEvent decode_csi_final(unsigned char final_byte) const;
+  static KeyEvent decode_ss3_final(unsigned char final_byte);
+  void reset();
+
+  State state_ = State::kGround;
+  int first_param_ = 0;
+  bool in_first_param_ = true;
+};
+
+// Buffered key source over a file descriptor. Each refill takes everything the terminal has
+// queued in one read(2), so pasted text and auto-repeat are decoded from memory.
+class KeyReader {
+ public:
+  static constexpr int kDefaultEscapeTimeoutMs = 100;
+
+  explicit KeyReader(int fd, int escape_timeout_ms = kDefaultEscapeTimeoutMs);
+
+  KeyEvent next();
+  bool has_buffered_input() const;
+
+ private:
+  enum class FillResult {
+    kData,
+    kTimeout,
+    kInterrupted,
+    kEof,
+  };
+
+  FillResult fill(int timeout_ms);
+
+  int fd_;
+  int escape_timeout_ms_;
+  KeyDecoder decoder_;
+  std::array<char, 4096> buffer_{};
+  std::size_t position_ = 0;
+  std::size_t length_ = 0;
+};
+
+}  // namespace adventure::ui
+
+#endif  // CLI_ADVENTURE_UI_KEY_READER_H_
@@ -0,0 +1,193 @@
+#include "ui/latency_recorder.h"
+
+#include <algorithm>
+#include <csignal>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+
+namespace adventure::ui {
+namespace {
+
+constexpr std::size_t kSubBucketBits = 4;
+constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+
+volatile std::sig_atomic_t g_dump_requested = 0;
+
+void dump_signal_handler(int) { g_dump_requested = 1; }
+
+std::size_t highest_bit(std::uint64_t value) {
+  std::size_t bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+}
+
+void write_summary(std::ostream& out, const LatencyHistogram& histogram) {
+  const auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+  out << std::fixed << std::setprecision(1) << "n=" << histogram.count()
+      << " p50=" << us(histogram.percentile(0.50)) << "us"
+      << " p99=" << us(histogram.percentile(0.99)) << "us"
+      << " p999=" << us(histogram.percentile(0.999)) << "us"
+      << " max=" << us(histogram.max()) << "us";
+}
+
+}  // namespace
+
+std::size_t LatencyHistogram::bucket_index(std::uint64_t value) {
+  if (value < kSubBuckets) {
+    return static_cast<std::size_t>(value);
+  }
+  const std::size_t exponent = highest_bit(value);
+  const std::size_t sub = static_cast<std::size_t>(value >> (exponent - kSubBucketBits)) &
+                          (kSubBuckets - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+std::uint64_t LatencyHistogram::bucket_midpoint(std::size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+  const std::size_t exponent = index / kSubBuckets + kSubBucketBits - 1;
+  const std::uint64_t sub = index % kSubBuckets;
+  const std::uint64_t width = std::uint64_t{1} << (exponent - kSubBucketBits);
+  return ((kSubBuckets + sub) << (exponent - kSubBucketBits)) + width / 2;
+}
+
+void LatencyHistogram::record(std::uint64_t nanoseconds) {
+  const std::size_t index = bucket_index(nanoseconds);
+  if (index >= counts_.size()) {
+    counts_.resize(index + 1, 0);
+  }
+  ++counts_[index];
+  ++total_;
+  max_ = std::max(max_, nanoseconds);
+}
+
+void LatencyHistogram::clear() {
+  counts_.clear();
+  total_ = 0;
+  max_ = 0;
+}
+
+std::uint64_t LatencyHistogram::percentile(double quantile) const {
+  if (total_ == 0) {
+    return 0;
+  }
+  const double clamped = std::min(std::max(quantile, 0.0), 1.0);
+  const std::uint64_t rank =
+      std::max<std::uint64_t>(1, static_cast<std::uint64_t>(clamped * static_cast<double>(total_) +
+                                                            0.999999));
+  if (rank >= total_) {
+    return max_;  // the largest sample is tracked exactly
+  }
+  std::uint64_t seen = 0;
+  for (std::size_t index = 0; index < counts_.size(); ++index) {
+    seen += counts_[index];
+    if (seen >= rank) {
+      return std::min(bucket_midpoint(index), max_);
+    }
+  }
+  return max_;
+}
+
+void LatencyRecorder::enable(std::filesystem::path log_path) {
+  log_path_ = std::move(log_path);
+  struct sigaction action {};
+  action.sa_handler = dump_signal_handler;
+  sigemptyset(&action.sa_mask);
+  action.sa_flags = SA_RESTART;  // never disturb a blocked read; the dump waits for the next event
+  sigaction(SIGUSR1, &action, nullptr);
+}
+
+void LatencyRecorder::begin_session(std::string name) {
+  session_name_ = std::move(name);
+  input_pending_ = false;
+  session_.clear();
+  per_scene_.clear();
+}
+
+void LatencyRecorder::end_session() {
+  input_pending_ = false;
+  if (enabled()) {
+    append_report_to_log();
+  }
+}
+
+void LatencyRecorder::input_committed() {
+  if (!enabled()) {
+    return;
+  }
+  check_dump_request();
+  input_pending_ = true;
+  input_time_ = Clock::now();
+}
+
+void LatencyRecorder::frame_presented(const std::string& scene_key) {
+  if (!enabled() || !input_pending_) {
+    return;
+  }
+  const std::uint64_t elapsed = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - input_time_).count());
+  input_pending_ = false;
+
+  session_.record(elapsed);
+  auto it = per_scene_.find(scene_key);
+  if (it == per_scene_.end()) {
+    it = per_scene_.emplace(scene_key, LatencyHistogram{}).first;
+  }
+  it->second.record(elapsed);
+  check_dump_request();
+}
+
+void LatencyRecorder::write_report(std::ostream& out) const {
+  out << "session " << session_name_ << " ";
+  write_summary(out, session_);
+  out << "\n";
+
+  // Slowest scenes first, by p99.
+  std::vector<const std::pair<const std::string, LatencyHistogram>*> scenes;
+  scenes.reserve(per_scene_.size());
+  for (const auto& scene : per_scene_) {
+    scenes.push_back(&scene);
+  }
+  std::sort(scenes.begin(), scenes.end(), [](const auto* left, const auto* right) {
+    const std::uint64_t left_p99 = left->second.percentile(0.99);
+    const std::uint64_t right_p99 = right->second.percentile(0.99);
+    return left_p99 != right_p99 ? left_p99 > right_p99 : left->first < right->first;
+  });
+  for (const auto* scene : scenes) {
+    out << "  level " << scene->first << " ";
+    write_summary(out, scene->second);
+    out << "\n";
+  }
+}
+
+void LatencyRecorder::append_report_to_log() const {
+  std::ofstream log(log_path_, std::ios::app);
+  if (log.is_open()) {
+    write_report(log);
+  }
+}
+
+void LatencyRecorder::check_dump_request() const {
+  if (g_dump_requested != 0) {
+    g_dump_requested = 0;
+    append_report_to_log();
+  }
+}
+
+LatencyRecorder& latency_recorder() {
+  static LatencyRecorder recorder = []() {
+    LatencyRecorder configured;
+    const char* log_path = std::getenv("CLI_ADVENTURE_LATENCY_LOG");
+    if (log_path != nullptr && *log_path != '\0') {
+      configured.enable(log_path);
+    }
+    return configured;
+  }();
+  return recorder;
+}
+
+}  // namespace adventure::ui
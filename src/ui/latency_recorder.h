@@ -0,0 +1,72 @@
+#ifndef CLI_ADVENTURE_UI_LATENCY_RECORDER_H_
+#define CLI_ADVENTURE_UI_LATENCY_RECORDER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace adventure::ui {
+
+// Log-bucketed histogram in the style of HdrHistogram: each power-of-two range of nanoseconds
+// is split into 16 linear sub-buckets, so any recorded value is reported within ~6%.
+class LatencyHistogram {
+ public:
+  void record(std::uint64_t nanoseconds);
+  void clear();
+
+  std::uint64_t count() const { return total_; }
+  std::uint64_t max() const { return max_; }
+  // Representative value of the bucket holding the `quantile` (0..1) sample.
+  std::uint64_t percentile(double quantile) const;
+
+ private:
+  static std::size_t bucket_index(std::uint64_t value);
+  static std::uint64_t bucket_midpoint(std::size_t index);
+
+  std::vector<std::uint64_t> counts_;  // grown on demand up to the largest bucket used
+  std::uint64_t total_ = 0;
+  std::uint64_t max_ = 0;
+};
+
+// Measures input-to-frame latency: the time from Enter being accepted by a menu or input prompt
+// until the next scene frame has been written out. Samples go to a per-session histogram and to
+// one histogram per scene (level path). Disabled unless a log file is configured, in which case
+// a report is appended at session end and after SIGUSR1 (at the next input or frame).
+class LatencyRecorder {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  bool enabled() const { return !log_path_.empty(); }
+  void enable(std::filesystem::path log_path);
+
+  void begin_session(std::string name);
+  void end_session();
+
+  void input_committed();
+  void frame_presented(const std::string& scene_key);
+
+  const LatencyHistogram& session_histogram() const { return session_; }
+  void write_report(std::ostream& out) const;
+
+ private:
+  void append_report_to_log() const;
+  void check_dump_request() const;
+
+  std::filesystem::path log_path_;
+  std::string session_name_;
+  bool input_pending_ = false;
+  Clock::time_point input_time_{};
+  LatencyHistogram session_;
+  std::unordered_map<std::string, LatencyHistogram> per_scene_;
+};
+
+// Process-wide recorder, enabled when CLI_ADVENTURE_LATENCY_LOG names a log file.
+LatencyRecorder& latency_recorder();
+
+}  // namespace adventure::ui
+
+#endif  // CLI_ADVENTURE_UI_LATENCY_RECORDER_H_
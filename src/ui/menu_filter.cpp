@@ -0,0 +1,65 @@
+#include "ui/menu_filter.h"
+
+#include <cctype>
+#include <utility>
+
+namespace adventure::ui {
+namespace {
+
+char lower_char(char ch) {
+  return static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+}
+
+}  // namespace
+
+MenuFilter::MenuFilter(const std::vector<std::string>& labels) {
+  lowered_labels_.reserve(labels.size());
+  std::vector<std::size_t> all;
+  all.reserve(labels.size());
+  for (std::size_t index = 0; index < labels.size(); ++index) {
+    std::string lowered = labels[index];
+    for (char& ch : lowered) {
+      ch = lower_char(ch);
+    }
+    lowered_labels_.push_back(std::move(lowered));
+    all.push_back(index);
+  }
+  match_stack_.push_back(std::move(all));
+}
+
+const std::string& MenuFilter::query() const { return query_; }
+
+const std::vector<std::size_t>& MenuFilter::matches() const { return match_stack_.back(); }
+
+void MenuFilter::push(char ch) {
+  query_.push_back(ch);
+  lowered_query_.push_back(lower_char(ch));
+
+  const std::vector<std::size_t>& previous = match_stack_.back();
+  std::vector<std::size_t> refined;
+  refined.reserve(previous.size());
+  for (std::size_t index : previous) {
+    if (lowered_labels_[index].find(lowered_query_) != std::string::npos) {
+      refined.push_back(index);
+    }
+  }
+  match_stack_.push_back(std::move(refined));
+}
+
+bool MenuFilter::pop() {
+  if (query_.empty()) {
+    return false;
+  }
+  query_.pop_back();
+  lowered_query_.pop_back();
+  match_stack_.pop_back();
+  return true;
+}
+
+void MenuFilter::clear() {
+  query_.clear();
+  lowered_query_.clear();
+  match_stack_.resize(1);
+}
+
+}  // namespace adventure::ui
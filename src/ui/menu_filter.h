@@ -0,0 +1,33 @@
+#ifndef CLI_ADVENTURE_UI_MENU_FILTER_H_
+#define CLI_ADVENTURE_UI_MENU_FILTER_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace adventure::ui {
+
+// Incremental case-insensitive substring filter over menu labels. Labels are lowercased once;
+// each typed character narrows the previous match set (a longer query can only match a subset),
+// and the per-length match sets are kept so Backspace is free.
+class MenuFilter {
+ public:
+  explicit MenuFilter(const std::vector<std::string>& labels);
+
+  const std::string& query() const;
+  const std::vector<std::size_t>& matches() const;
+
+  void push(char ch);
+  bool pop();
+  void clear();
+
+ private:
+  std::vector<std::string> lowered_labels_;
+  std::string query_;
+  std::string lowered_query_;
+  std::vector<std::vector<std::size_t>> match_stack_;
+};
+
+}  // namespace adventure::ui
+
+#endif  // CLI_ADVENTURE_UI_MENU_FILTER_H_
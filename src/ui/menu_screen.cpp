@@ -0,0 +1,184 @@
+#include "ui/menu_screen.h"
+
+#include <algorithm>
+
+namespace adventure::ui {
+
+MenuScreen::MenuScreen(std::ostream& out, const std::vector<std::string>& options,
+                       const std::vector<std::size_t>& view, const std::string& prompt,
+                       const CompiledTheme& theme, std::size_t terminal_rows)
+    : out_(out), options_(options), view_(&view), prompt_(prompt), theme_(theme) {
+  layout(terminal_rows);
+}
+
+void MenuScreen::draw(std::size_t selected) {
+  scroll_to(selected);
+
+  frame_.clear();
+  frame_ += theme_.prompt.prefix;
+  frame_ += prompt_;
+  if (!filter_.empty()) {
+    frame_ += " /";
+    frame_ += filter_;
+  }
+  frame_ += theme_.prompt.reset;
+  frame_ += "\n";
+  if (view_->empty()) {
+    frame_ += theme_.unselected.prefix;
+    frame_ += "  (no matches)";
+    frame_ += theme_.unselected.reset;
+    frame_ += "\n";
+  }
+  for (std::size_t row = 0; row < window_rows_; ++row) {
+    append_row(top_ + row, top_ + row == selected);
+    frame_ += "\n";
+  }
+  if (is_paged()) {
+    append_status();
+    frame_ += "\n";
+  }
+
+  drawn_selected_ = selected;
+  drawn_lines_ = 1 + std::max<std::size_t>(window_rows_, 1) + (is_paged() ? 1 : 0);
+  flush_frame();
+}
+
+void MenuScreen::select(std::size_t selected) {
+  if (selected == drawn_selected_ || view_->empty()) {
+    return;
+  }
+
+  frame_.clear();
+  if (scroll_to(selected)) {
+    rewrite_window(selected);
+  } else {
+    rewrite_row(drawn_selected_, false);
+    rewrite_row(selected, true);
+  }
+  drawn_selected_ = selected;
+  flush_frame();
+}
+
+void MenuScreen::resize(std::size_t terminal_rows) {
+  erase_block();
+  layout(terminal_rows);
+  draw(drawn_selected_);
+}
+
+void MenuScreen::set_view(const std::vector<std::size_t>& view, const std::string& filter,
+                          std::size_t selected) {
+  erase_block();
+  view_ = &view;
+  filter_ = filter;
+  top_ = 0;
+  layout(terminal_rows_);
+  draw(selected);
+}
+
+std::size_t MenuScreen::page_size() const { return std::max<std::size_t>(window_rows_, 1); }
+
+std::size_t MenuScreen::rendered_lines() const { return drawn_lines_; }
+
+std::size_t MenuScreen::view_size() const { return view_->size(); }
+
+bool MenuScreen::is_paged() const { return window_rows_ < view_->size(); }
+
+void MenuScreen::layout(std::size_t terminal_rows) {
+  // Reserve the prompt line and the resting cursor line; a paged menu also needs a status line.
+  terminal_rows_ = terminal_rows;
+  const std::size_t available = terminal_rows > 2 ? terminal_rows - 2 : 1;
+  if (view_->size() <= available) {
+    window_rows_ = view_->size();
+  } else {
+    window_rows_ = std::max<std::size_t>(available - 1, 1);
+  }
+  top_ = std::min(top_, view_->size() - window_rows_);
+}
+
+bool MenuScreen::scroll_to(std::size_t selected) {
+  if (view_->empty()) {
+    return false;
+  }
+  std::size_t top = top_;
+  if (selected < top) {
+    top = selected;
+  } else if (selected >= top + window_rows_) {
+    top = selected + 1 - window_rows_;
+  }
+  if (top == top_) {
+    return false;
+  }
+  top_ = top;
+  return true;
+}
+
+void MenuScreen::append_row(std::size_t position, bool is_selected) {
+  const std::string& label = options_[(*view_)[position]];
+  if (is_selected) {
+    frame_ += theme_.selected_prefix;
+    frame_ += label;
+    frame_ += theme_.selected.reset;
+  } else {
+    frame_ += theme_.unselected_prefix;
+    frame_ += label;
+    frame_ += theme_.unselected.reset;
+  }
+}
+
+void MenuScreen::append_status() {
+  frame_ += theme_.prompt.prefix;
+  frame_ += "  [";
+  frame_ += std::to_string(top_ + 1);
+  frame_ += "-";
+  frame_ += std::to_string(top_ + window_rows_);
+  frame_ += " of ";
+  frame_ += std::to_string(view_->size());
+  frame_ += "] PgUp/PgDn to scroll";
+  frame_ += theme_.prompt.reset;
+}
+
+void MenuScreen::rewrite_row(std::size_t position, bool is_selected) {
+  const std::string distance = std::to_string(drawn_lines_ - (position - top_ + 1));
+  frame_ += "\033[";
+  frame_ += distance;
+  frame_ += "A\r\033[2K";
+  append_row(position, is_selected);
+  frame_ += "\r\033[";
+  frame_ += distance;
+  frame_ += "B";
+}
+
+void MenuScreen::rewrite_window(std::size_t selected) {
+  frame_ += "\033[";
+  frame_ += std::to_string(drawn_lines_ - 1);
+  frame_ += "A";
+  for (std::size_t row = 0; row < window_rows_; ++row) {
+    frame_ += "\r\033[2K";
+    append_row(top_ + row, top_ + row == selected);
+    frame_ += "\n";
+  }
+  if (is_paged()) {
+    frame_ += "\r\033[2K";
+    append_status();
+    frame_ += "\n";
+  }
+}
+
+void MenuScreen::erase_block() {
+  // Move to the first line of the drawn block and clear everything below it.
+  frame_.clear();
+  if (drawn_lines_ > 0) {
+    frame_ += "\033[";
+    frame_ += std::to_string(drawn_lines_);
+    frame_ += "A\r\033[J";
+  }
+  flush_frame();
+  drawn_lines_ = 0;
+}
+
+void MenuScreen::flush_frame() {
+  out_.write(frame_.data(), static_cast<std::streamsize>(frame_.size()));
+  out_.flush();
+}
+
+}  // namespace adventure::ui
@@ -0,0 +1,62 @@
+#ifndef CLI_ADVENTURE_UI_MENU_SCREEN_H_
+#define CLI_ADVENTURE_UI_MENU_SCREEN_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ui/theme.h"
+
+namespace adventure::ui {
+
+// On-screen model of an interactive menu. Only a terminal-sized window of the options is drawn;
+// moving the selection inside the window rewrites just the two affected rows, and scrolling
+// rewrites the window. Between frames the cursor rests on the line below the menu block.
+//
+// The screen shows a view: a list of indices into `options` (all of them unless a filter is
+// applied). Selection positions passed to draw()/select() are positions within that view.
+class MenuScreen {
+ public:
+  MenuScreen(std::ostream& out, const std::vector<std::string>& options,
+             const std::vector<std::size_t>& view, const std::string& prompt,
+             const CompiledTheme& theme, std::size_t terminal_rows);
+
+  void draw(std::size_t selected);
+  void select(std::size_t selected);
+  void resize(std::size_t terminal_rows);
+  void set_view(const std::vector<std::size_t>& view, const std::string& filter,
+                std::size_t selected);
+
+  std::size_t page_size() const;
+  std::size_t rendered_lines() const;
+  std::size_t view_size() const;
+
+ private:
+  bool is_paged() const;
+  void layout(std::size_t terminal_rows);
+  bool scroll_to(std::size_t selected);
+  void append_row(std::size_t position, bool is_selected);
+  void append_status();
+  void rewrite_row(std::size_t position, bool is_selected);
+  void rewrite_window(std::size_t selected);
+  void erase_block();
+  void flush_frame();
+
+  std::ostream& out_;
+  const std::vector<std::string>& options_;
+  const std::vector<std::size_t>* view_;
+  const std::string& prompt_;
+  std::string filter_;
+  std::size_t terminal_rows_ = 0;
+  const CompiledTheme& theme_;
+  std::size_t window_rows_ = 0;
+  std::size_t top_ = 0;
+  std::size_t drawn_selected_ = 0;
+  std::size_t drawn_lines_ = 0;
+  std::string frame_;
+};
+
+}  // namespace adventure::ui
+
+#endif  // CLI_ADVENTURE_UI_MENU_SCREEN_H_
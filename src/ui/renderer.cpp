@@ -2,12 +2,23 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <stdexcept>
+#include <string_view>
 #include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
+#include "ui/latency_recorder.h"
+#include "ui/terminal_menu.h"
+
 namespace adventure::ui {
 namespace {
 
@@ -88,7 +99,7 @@ ParsedLeadingTag parse_leading_tag(const std::string& raw_line) {
   return parsed;
 }
 
-bool is_whitespace_only(const std::string& text) {
+bool is_whitespace_only(std::string_view text) {
   for (char ch : text) {
     if (std::isspace(static_cast<unsigned char>(ch)) == 0) {
       return false;
@@ -115,46 +126,217 @@ bool parse_default_color_directive(const std::string& raw_line, std::string* col
   return true;
 }
 
+// Read-only mapping of a level file for the content pager.
+class MappedFile {
+ public:
+  explicit MappedFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::runtime_error("Could not open level file: " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      size_ = static_cast<std::size_t>(info.st_size);
+      void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (data == MAP_FAILED) {
+        ::close(fd);
+        throw std::runtime_error("Could not map level file: " + path);
+      }
+      ::madvise(data, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(data);
+    }
+    ::close(fd);
+  }
+
+  ~MappedFile() {
+    if (data_ != nullptr) {
+      ::munmap(const_cast<char*>(data_), size_);
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Clamped to the file, which may have been truncated since it was parsed.
+  std::string_view range(const adventure::parser::ContentRange& range) const {
+    if (data_ == nullptr || range.offset >= size_) {
+      return {};
+    }
+    const std::size_t offset = static_cast<std::size_t>(range.offset);
+    const std::size_t length =
+        static_cast<std::size_t>(std::min<std::uint64_t>(range.length, size_ - offset));
+    return std::string_view(data_ + offset, length);
+  }
+
+ private:
+  const char* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
 }  // namespace
 
-Renderer::Renderer(Theme theme) : theme_(std::move(theme)) {}
+Renderer::Renderer(Theme theme)
+    : theme_(std::move(theme)), compiled_(compile_theme(theme_, detect_color_depth())) {}
 
 const Theme& Renderer::theme() const { return theme_; }
 
+const CompiledTheme& Renderer::compiled_theme() const { return compiled_; }
+
 void Renderer::render_scene(std::ostream& out, const std::string& title,
                             const std::vector<std::string>& content_lines,
                             const std::string& current_directory,
                             const std::string& ascii_art_relative_path) const {
-  std::size_t rendered_lines = 0;
+  const SceneFrame frame =
+      build_scene_frame(title, content_lines, current_directory, ascii_art_relative_path);
+  emit_frame(out, frame);
+}
 
-  out << "\n" << colorize(theme_.border_line, theme_.title_color) << "\n";
-  out << colorize(title, theme_.title_color) << "\n";
-  out << colorize(theme_.border_line, theme_.title_color) << "\n\n";
-  rendered_lines += 5;
+void Renderer::render_cached_scene(std::ostream& out, const std::string& scene_key,
+                                   const std::string& title,
+                                   const adventure::parser::TextLines& content_lines,
+                                   const std::string& current_directory,
+                                   const std::string& ascii_art_relative_path) const {
+  if (scene_key.empty()) {
+    emit_frame(out,
+               build_scene_frame(title, content_lines, current_directory, ascii_art_relative_path));
+    return;
+  }
 
-  for (const std::string& line : content_lines) {
-    out << colorize(line, theme_.body_color) << "\n";
+  auto it = scene_cache_.find(scene_key);
+  if (it == scene_cache_.end()) {
+    it = scene_cache_
+             .emplace(scene_key, build_scene_frame(title, content_lines, current_directory,
+                                                   ascii_art_relative_path))
+             .first;
   }
-  rendered_lines += content_lines.size();
+  emit_frame(out, it->second);
+  latency_recorder().frame_presented(scene_key);
+}
+
+template <typename Lines>
+Renderer::SceneFrame Renderer::build_scene_frame(
+    const std::string& title, const Lines& content_lines, const std::string& current_directory,
+    const std::string& ascii_art_relative_path) const {
+  SceneFrame frame;
+  std::string& bytes = frame.bytes;
+
+  std::size_t estimated_size = 2 * compiled_.border_line.size() + title.size() + 64;
+  for (const std::string_view line : content_lines) {
+    estimated_size += line.size() + 16;
+  }
+  bytes.reserve(estimated_size);
+
+  bytes += "\n";
+  bytes += compiled_.border_line;
+  bytes += "\n";
+  append_colorized(&bytes, title, compiled_.title);
+  bytes += "\n";
+  bytes += compiled_.border_line;
+  bytes += "\n\n";
+  frame.line_count += 5;
+
+  for (const std::string_view line : content_lines) {
+    append_colorized(&bytes, line, compiled_.body);
+    bytes += "\n";
+  }
+  frame.line_count += content_lines.size();
 
   if (!ascii_art_relative_path.empty()) {
     const std::vector<AsciiArtLine> art =
         load_ascii_art(current_directory, ascii_art_relative_path);
     if (art.empty()) {
-      render_structure_error(out, "ASCII art not found: " + ascii_art_relative_path);
-      rendered_lines += 2;
+      bytes += "\n";
+      append_colorized(&bytes, "[Structure Error] ASCII art not found: " + ascii_art_relative_path,
+                       compiled_.error);
+      bytes += "\n";
+      frame.line_count += 2;
     } else {
       for (const AsciiArtLine& line : art) {
-        const std::string color_name =
-            line.color_name.empty() ? theme_.body_color : line.color_name;
-        out << colorize(line.text, color_name) << "\n";
+        if (line.color_name.empty()) {
+          append_colorized(&bytes, line.text, compiled_.body);
+        } else {
+          append_colorized(&bytes, line.text,
+                           compile_color(line.color_name, compiled_.use_color, compiled_.depth));
+        }
+        bytes += "\n";
+      }
+      bytes += "\n";
+      frame.line_count += art.size() + 1;
+    }
+  }
+
+  return frame;
+}
+
+void Renderer::emit_frame(std::ostream& out, const SceneFrame& frame) const {
+  last_scene_lines_ = frame.line_count;
+
+  if (&out != &std::cout) {
+    out.write(frame.bytes.data(), static_cast<std::streamsize>(frame.bytes.size()));
+    return;
+  }
+
+  // Hand the whole frame to the kernel at once instead of streaming it line by line.
+  out.flush();
+  const char* data = frame.bytes.data();
+  std::size_t remaining = frame.bytes.size();
+  while (remaining > 0) {
+    const ssize_t written = ::write(STDOUT_FILENO, data, remaining);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
       }
-      out << "\n";
-      rendered_lines += art.size() + 1;
+      out.setstate(std::ios::badbit);
+      return;
     }
+    data += written;
+    remaining -= static_cast<std::size_t>(written);
+  }
+}
+
+void Renderer::render_streamed_content(std::istream& in, std::ostream& out,
+                                       const adventure::parser::StreamedContent& content) const {
+  if (content.empty()) {
+    return;
   }
 
-  last_scene_lines_ = rendered_lines;
+  const MappedFile file(content.path);
+  const bool is_interactive = supports_interactive_menu(in, out);
+  // One row stays free for the `--More--` prompt; the first page shares the screen with the
+  // scene header.
+  const std::size_t page_rows = std::max<std::size_t>(terminal_rows(), 2) - 1;
+  std::size_t rows_left = page_rows > last_scene_lines_ ? page_rows - last_scene_lines_ : 1;
+
+  std::string line_bytes;
+  for (const adventure::parser::ContentRange& range : content.ranges) {
+    std::string_view text = file.range(range);
+    while (!text.empty()) {
+      const std::size_t end = text.find('\n');
+      std::string_view line = text.substr(0, end);
+      text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+
+      if (is_interactive && rows_left == 0) {
+        const MoreAction action = wait_for_more(out, compiled_);
+        if (action == MoreAction::kSkipRest) {
+          return;
+        }
+        rows_left = action == MoreAction::kNextPage ? page_rows : 1;
+      }
+
+      if (is_whitespace_only(line)) {
+        line = std::string_view();
+      }
+      line_bytes.clear();
+      append_colorized(&line_bytes, line, compiled_.body);
+      line_bytes += "\n";
+      out.write(line_bytes.data(), static_cast<std::streamsize>(line_bytes.size()));
+      ++last_scene_lines_;
+      if (is_interactive) {
+        --rows_left;
+      }
+    }
+  }
+  out.flush();
 }
 
 void Renderer::clear_last_scene(std::ostream& out, std::size_t extra_lines_after_scene) const {
@@ -179,15 +361,20 @@ void Renderer::clear_last_scene(std::ostream& out, std::size_t extra_lines_after
 }
 
 void Renderer::render_victory(std::ostream& out) const {
-  out << "\n" << colorize("[Victory]", theme_.victory_color) << "\n";
+  write_status_line(out, "[Victory]", compiled_.victory);
 }
 
 void Renderer::render_game_over(std::ostream& out) const {
-  out << "\n" << colorize("[Game Over]", theme_.game_over_color) << "\n";
+  write_status_line(out, "[Game Over]", compiled_.game_over);
 }
 
 void Renderer::render_structure_error(std::ostream& out, const std::string& message) const {
-  out << "\n" << colorize("[Structure Error] " + message, theme_.error_color) << "\n";
+  write_status_line(out, "[Structure Error] " + message, compiled_.error);
+}
+
+void Renderer::write_status_line(std::ostream& out, const std::string& text,
+                                 const CompiledColor& color) const {
+  out << "\n" << color.prefix << text << color.reset << "\n";
 }
 
 Renderer::AsciiArtLine Renderer::parse_ascii_art_line(const std::string& raw_line) {
@@ -207,16 +394,11 @@ bool Renderer::parse_ascii_art_default_color_directive(const std::string& raw_li
   return parse_default_color_directive(raw_line, color_name);
 }
 
-std::string Renderer::colorize(const std::string& text, const std::string& color_name) const {
-  if (!theme_.use_color) {
-    return text;
-  }
-
-  const std::string code = ansi_color_code(color_name);
-  if (code.empty()) {
-    return text;
-  }
-  return code + text + "\033[0m";
+void Renderer::append_colorized(std::string* buffer, std::string_view text,
+                                const CompiledColor& color) {
+  buffer->append(color.prefix);
+  buffer->append(text);
+  buffer->append(color.reset);
 }
 
 std::vector<Renderer::AsciiArtLine> Renderer::load_ascii_art(
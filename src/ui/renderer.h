@@ -2,10 +2,15 @@
 #define CLI_ADVENTURE_UI_RENDERER_H_
 
 #include <cstddef>
+#include <istream>
 #include <ostream>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "parser/parsed_level.h"
+#include "parser/text_lines.h"
 #include "ui/theme.h"
 
 namespace adventure::ui {
@@ -15,11 +20,26 @@ class Renderer {
   explicit Renderer(Theme theme);
 
   const Theme& theme() const;
+  const CompiledTheme& compiled_theme() const;
 
   void render_scene(std::ostream& out, const std::string& title,
                     const std::vector<std::string>& content_lines,
                     const std::string& current_directory,
                     const std::string& ascii_art_relative_path) const;
+  // Same as render_scene for a level's parsed content, but the composed frame is cached under
+  // `scene_key` (normally the level path) so revisiting a level re-emits the stored bytes
+  // without re-rendering.
+  void render_cached_scene(std::ostream& out, const std::string& scene_key,
+                           const std::string& title,
+                           const adventure::parser::TextLines& content_lines,
+                           const std::string& current_directory,
+                           const std::string& ascii_art_relative_path) const;
+  // Writes content the parser left in the level file below the scene last rendered. The file is
+  // mapped only while paging and the lines are written one at a time, so memory does not grow
+  // with the content. On an interactive terminal it stops at each screenful with a `--More--`
+  // prompt; otherwise everything is written. The lines count towards clear_last_scene.
+  void render_streamed_content(std::istream& in, std::ostream& out,
+                               const adventure::parser::StreamedContent& content) const;
   void clear_last_scene(std::ostream& out, std::size_t extra_lines_after_scene = 0) const;
 
   void render_victory(std::ostream& out) const;
@@ -32,15 +52,31 @@ class Renderer {
     std::string color_name;
   };
 
+  struct SceneFrame {
+    std::string bytes;
+    std::size_t line_count = 0;
+  };
+
   static bool parse_ascii_art_default_color_directive(const std::string& raw_line,
                                                       std::string* color_name);
   static AsciiArtLine parse_ascii_art_line(const std::string& raw_line);
-  std::string colorize(const std::string& text, const std::string& color_name) const;
+  static void append_colorized(std::string* buffer, std::string_view text,
+                               const CompiledColor& color);
+  void write_status_line(std::ostream& out, const std::string& text,
+                         const CompiledColor& color) const;
+  // `Lines` is std::vector<std::string> or parser::TextLines; both are instantiated in the .cpp.
+  template <typename Lines>
+  SceneFrame build_scene_frame(const std::string& title, const Lines& content_lines,
+                               const std::string& current_directory,
+                               const std::string& ascii_art_relative_path) const;
+  void emit_frame(std::ostream& out, const SceneFrame& frame) const;
   std::vector<AsciiArtLine> load_ascii_art(const std::string& current_directory,
                                            const std::string& ascii_art_relative_path) const;
 
   mutable std::size_t last_scene_lines_ = 0;
+  mutable std::unordered_map<std::string, SceneFrame> scene_cache_;
   Theme theme_;
+  CompiledTheme compiled_;
 };
 
 }  // namespace adventure::ui
@@ -7,20 +7,18 @@
 #include <stdexcept>
 #include <string>
 
+#include <sys/ioctl.h>
 #include <termios.h>
 #include <unistd.h>
 
+#include "ui/key_reader.h"
+#include "ui/latency_recorder.h"
+#include "ui/menu_filter.h"
+#include "ui/menu_screen.h"
+
 namespace adventure::ui {
 namespace {
 
-enum class Key {
-  kUp,
-  kDown,
-  kEnter,
-  kUnknown,
-  kEof,
-};
-
 termios g_original_termios{};
 bool g_has_original_termios = false;
 bool g_raw_mode_active = false;
@@ -92,68 +90,40 @@ class ScopedRawMode {
   termios original_{};
 };
 
-Key read_key() {
-  char ch = 0;
-  const ssize_t n = read(STDIN_FILENO, &ch, 1);
-  if (n <= 0) {
-    return Key::kEof;
-  }
-
-  if (ch == '\n' || ch == '\r') {
-    return Key::kEnter;
-  }
-  if (ch == '\x1b') {
-    char seq[2] = {0, 0};
-    if (read(STDIN_FILENO, &seq[0], 1) <= 0 || read(STDIN_FILENO, &seq[1], 1) <= 0) {
-      return Key::kUnknown;
-    }
-    if (seq[0] == '[' && seq[1] == 'A') {
-      return Key::kUp;
-    }
-    if (seq[0] == '[' && seq[1] == 'B') {
-      return Key::kDown;
-    }
-    return Key::kUnknown;
-  }
-  return Key::kUnknown;
+// Shared across menus so bytes already read past one selection (paste, typed-ahead keys) are
+// still delivered to the next prompt.
+KeyReader& stdin_key_reader() {
+  static KeyReader reader(STDIN_FILENO);
+  return reader;
 }
 
-void render_menu(std::ostream& out, const std::vector<std::string>& options,
-                 const std::string& prompt, std::size_t selected, bool redraw,
-                 const Theme& theme) {
-  const std::size_t lines = options.size() + 1;
-  if (redraw) {
-    out << "\033[" << lines << "A";
-    for (std::size_t i = 0; i < lines; ++i) {
-      out << "\033[2K\r";
-      if (i + 1 < lines) {
-        out << "\033[1B";
-      }
-    }
-    out << "\033[" << (lines - 1) << "A";
+volatile std::sig_atomic_t g_resize_pending = 0;
+
+void resize_signal_handler(int) { g_resize_pending = 1; }
+
+// Installs a SIGWINCH handler without SA_RESTART so a blocked key read returns and the menu can
+// re-layout for the new terminal size.
+class ScopedResizeHandler {
+ public:
+  ScopedResizeHandler() {
+    struct sigaction action {};
+    action.sa_handler = resize_signal_handler;
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = 0;
+    active_ = sigaction(SIGWINCH, &action, &previous_) == 0;
+    g_resize_pending = 0;
   }
 
-  const auto colorize = [&theme](const std::string& text, const std::string& color) {
-    if (!theme.use_color) {
-      return text;
-    }
-    const std::string code = ansi_color_code(color);
-    if (code.empty()) {
-      return text;
+  ~ScopedResizeHandler() {
+    if (active_) {
+      sigaction(SIGWINCH, &previous_, nullptr);
     }
-    return code + text + "\033[0m";
-  };
-
-  out << colorize(prompt, theme.prompt_color) << "\n";
-  for (std::size_t index = 0; index < options.size(); ++index) {
-    const bool is_selected = index == selected;
-    const std::string prefix =
-        is_selected ? (theme.menu_selected_prefix + " ") : (theme.menu_unselected_prefix + " ");
-    out << colorize(prefix + options[index], is_selected ? theme.selected_color : theme.unselected_color);
-    out << "\n";
   }
-  out.flush();
-}
+
+ private:
+  bool active_ = false;
+  struct sigaction previous_ {};
+};
 
 bool try_parse_index(const std::string& input, std::size_t option_count, std::size_t* index) {
   std::string trimmed = input;
@@ -196,6 +166,7 @@ MenuSelection pick_option_fallback(std::istream& in, std::ostream& out,
   while (std::getline(in, line)) {
     std::size_t selected = 0;
     if (try_parse_index(line, options.size(), &selected)) {
+      latency_recorder().input_committed();
       return MenuSelection{selected, options.size() + 2};
     }
     out << "Invalid selection. Enter a number from 1 to " << options.size() << ": ";
@@ -205,35 +176,109 @@ MenuSelection pick_option_fallback(std::istream& in, std::ostream& out,
 }
 
 MenuSelection pick_option_interactive(std::ostream& out, const std::vector<std::string>& options,
-                                      const std::string& prompt, const Theme& theme) {
+                                      const std::string& prompt,
+                                      const CompiledTheme& theme) {
   ScopedRawMode raw_mode;
+  ScopedResizeHandler resize_handler;
+  MenuFilter filter(options);
   std::size_t selected = 0;
-  render_menu(out, options, prompt, selected, false, theme);
+  bool view_changed = false;
+  MenuScreen screen(out, options, filter.matches(), prompt, theme, terminal_rows());
+  screen.draw(selected);
+
+  // Typed characters narrow the list; keep the highlighted option if it is still visible.
+  const auto refilter = [&](const auto& edit) {
+    const std::vector<std::size_t>& before = filter.matches();
+    const std::size_t selected_option = before.empty() ? 0 : before[selected];
+    if (!edit()) {
+      return;
+    }
+    const std::vector<std::size_t>& after = filter.matches();
+    const auto it = std::lower_bound(after.begin(), after.end(), selected_option);
+    selected = (it != after.end() && *it == selected_option)
+                   ? static_cast<std::size_t>(it - after.begin())
+                   : 0;
+    view_changed = true;
+  };
+  const auto sync_screen = [&]() {
+    if (view_changed) {
+      screen.set_view(filter.matches(), filter.query(), selected);
+      view_changed = false;
+    } else {
+      screen.select(selected);
+    }
+  };
 
+  KeyReader& reader = stdin_key_reader();
   while (true) {
-    const Key key = read_key();
-    if (key == Key::kEof) {
+    const KeyEvent key = reader.next();
+    if (g_resize_pending != 0) {
+      g_resize_pending = 0;
+      sync_screen();
+      screen.resize(terminal_rows());
+    }
+    if (key.code == KeyCode::kEof) {
       throw std::runtime_error("Input stream closed before a selection was made.");
     }
-    if (key == Key::kEnter) {
+
+    const std::size_t visible = filter.matches().size();
+    if (key.code == KeyCode::kEnter) {
+      if (visible == 0) {
+        continue;
+      }
+      latency_recorder().input_committed();
+      sync_screen();
       out << "\n";
-      return MenuSelection{selected, options.size() + 2};
+      return MenuSelection{filter.matches()[selected], screen.rendered_lines() + 1};
     }
-    if (key == Key::kUp) {
-      selected = (selected == 0) ? (options.size() - 1) : (selected - 1);
-      render_menu(out, options, prompt, selected, true, theme);
+    if (key.code == KeyCode::kChar && !key.alt) {
+      refilter([&]() {
+        filter.push(key.ch);
+        return true;
+      });
+    } else if (key.code == KeyCode::kBackspace) {
+      refilter([&]() { return filter.pop(); });
+    } else if (key.code == KeyCode::kEscape) {
+      refilter([&]() {
+        const bool had_query = !filter.query().empty();
+        filter.clear();
+        return had_query;
+      });
+    } else if (visible == 0) {
       continue;
-    }
-    if (key == Key::kDown) {
-      selected = (selected + 1) % options.size();
-      render_menu(out, options, prompt, selected, true, theme);
+    } else if (key.code == KeyCode::kUp) {
+      selected = (selected == 0) ? (visible - 1) : (selected - 1);
+    } else if (key.code == KeyCode::kDown) {
+      selected = (selected + 1) % visible;
+    } else if (key.code == KeyCode::kHome) {
+      selected = 0;
+    } else if (key.code == KeyCode::kEnd) {
+      selected = visible - 1;
+    } else if (key.code == KeyCode::kPageUp) {
+      selected = selected > screen.page_size() ? selected - screen.page_size() : 0;
+    } else if (key.code == KeyCode::kPageDown) {
+      selected = std::min(selected + screen.page_size(), visible - 1);
+    } else {
       continue;
     }
+
+    // Held-down keys and pasted text arrive in bursts; draw once the burst has been consumed.
+    if (!reader.has_buffered_input()) {
+      sync_screen();
+    }
   }
 }
 
 }  // namespace
 
+std::size_t terminal_rows() {
+  winsize size{};
+  if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) == 0 && size.ws_row > 0) {
+    return size.ws_row;
+  }
+  return 24;
+}
+
 bool supports_interactive_menu(const std::istream& in, const std::ostream& out) {
   return (&in == &std::cin) && (&out == &std::cout) && isatty(STDIN_FILENO) &&
          isatty(STDOUT_FILENO);
@@ -241,7 +286,7 @@ bool supports_interactive_menu(const std::istream& in, const std::ostream& out)
 
 MenuSelection pick_option(std::istream& in, std::ostream& out,
                           const std::vector<std::string>& options, const std::string& prompt,
-                          const Theme& theme) {
+                          const CompiledTheme& theme) {
   if (options.empty()) {
     throw std::invalid_argument("pick_option requires at least one option.");
   }
@@ -275,12 +320,7 @@ void wait_for_continue(std::istream& in, std::ostream& out, const std::string& p
 
   if (supports_interactive_menu(in, out)) {
     ScopedRawMode raw_mode;
-    while (true) {
-      const Key key = read_key();
-      if (key == Key::kEof || key == Key::kEnter || key == Key::kUp || key == Key::kDown ||
-          key == Key::kUnknown) {
-        break;
-      }
+    while (stdin_key_reader().next().code == KeyCode::kInterrupted) {
     }
     out << "\n";
     return;
@@ -290,4 +330,30 @@ void wait_for_continue(std::istream& in, std::ostream& out, const std::string& p
   std::getline(in, line);
 }
 
+MoreAction wait_for_more(std::ostream& out, const CompiledTheme& theme) {
+  out << theme.prompt.prefix << "--More--" << theme.prompt.reset;
+  out.flush();
+
+  ScopedRawMode raw_mode;
+  MoreAction action = MoreAction::kSkipRest;
+  while (true) {
+    const KeyEvent key = stdin_key_reader().next();
+    if (key.code == KeyCode::kEof || key.code == KeyCode::kEscape ||
+        (key.code == KeyCode::kChar && (key.ch == 'q' || key.ch == 'Q'))) {
+      break;
+    }
+    if (key.code == KeyCode::kPageDown || (key.code == KeyCode::kChar && key.ch == ' ')) {
+      action = MoreAction::kNextPage;
+      break;
+    }
+    if (key.code == KeyCode::kEnter || key.code == KeyCode::kDown) {
+      action = MoreAction::kNextLine;
+      break;
+    }
+  }
+  out << "\r\033[2K";
+  out.flush();
+  return action;
+}
+
 }  // namespace adventure::ui
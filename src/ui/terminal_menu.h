@@ -20,10 +20,23 @@ struct MenuSelection {
 
 MenuSelection pick_option(std::istream& in, std::ostream& out,
                           const std::vector<std::string>& options, const std::string& prompt,
-                          const Theme& theme);
+                          const CompiledTheme& theme);
 void clear_menu_block(std::istream& in, std::ostream& out, std::size_t rendered_lines);
 void wait_for_continue(std::istream& in, std::ostream& out, const std::string& prompt);
 
+enum class MoreAction {
+  kNextPage,
+  kNextLine,
+  kSkipRest,
+};
+
+// Interactive `--More--` prompt for paged text: Space or Page Down shows the next page, Enter or
+// Down one more line, and `q` or Escape skips the rest. The prompt line is erased again.
+MoreAction wait_for_more(std::ostream& out, const CompiledTheme& theme);
+
+// Height of the output terminal; 24 when it cannot be queried.
+std::size_t terminal_rows();
+
 }  // namespace adventure::ui
 
 #endif  // CLI_ADVENTURE_UI_TERMINAL_MENU_H_
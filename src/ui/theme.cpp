@@ -1,14 +1,18 @@
 #include "ui/theme.h"
 
 #include <algorithm>
+#include <array>
 #include <cctype>
+#include <cstdint>
 #include <cstdlib>
 #include <fstream>
 #include <string>
-#include <unordered_map>
+#include <utility>
 
 #include <unistd.h>
 
+#include "parser/keyword_table.h"
+
 namespace adventure::ui {
 namespace {
 
@@ -45,6 +49,233 @@ bool parse_bool(const std::string& value, bool* result) {
   return false;
 }
 
+struct Rgb {
+  int r = 0;
+  int g = 0;
+  int b = 0;
+};
+
+// xterm default palette for the 16 basic colors.
+constexpr std::array<Rgb, 16> kBasicPalette = {{
+    {0, 0, 0},       {205, 0, 0},     {0, 205, 0},     {205, 205, 0},
+    {0, 0, 238},     {205, 0, 205},   {0, 205, 205},   {229, 229, 229},
+    {127, 127, 127}, {255, 0, 0},     {0, 255, 0},     {255, 255, 0},
+    {92, 92, 255},   {255, 0, 255},   {0, 255, 255},   {255, 255, 255},
+}};
+
+constexpr std::array<int, 6> kCubeLevels = {0, 95, 135, 175, 215, 255};
+
+// A parsed color value: one of the named basic colors, a 256-color index, or an RGB triple.
+struct ColorSpec {
+  enum class Kind {
+    kNone,
+    kDefault,
+    kBasic,
+    kIndexed,
+    kRgb,
+  };
+
+  Kind kind = Kind::kNone;
+  int index = 0;
+  Rgb rgb;
+};
+
+int distance_squared(const Rgb& left, const Rgb& right) {
+  const int dr = left.r - right.r;
+  const int dg = left.g - right.g;
+  const int db = left.b - right.b;
+  return dr * dr + dg * dg + db * db;
+}
+
+Rgb indexed_to_rgb(int index) {
+  if (index < 16) {
+    return kBasicPalette[static_cast<std::size_t>(index)];
+  }
+  if (index < 232) {
+    const int cube = index - 16;
+    return Rgb{kCubeLevels[static_cast<std::size_t>(cube / 36)],
+               kCubeLevels[static_cast<std::size_t>((cube / 6) % 6)],
+               kCubeLevels[static_cast<std::size_t>(cube % 6)]};
+  }
+  const int gray = 8 + (index - 232) * 10;
+  return Rgb{gray, gray, gray};
+}
+
+int rgb_to_basic(const Rgb& rgb) {
+  int best = 0;
+  int best_distance = distance_squared(rgb, kBasicPalette[0]);
+  for (int i = 1; i < 16; ++i) {
+    const int distance = distance_squared(rgb, kBasicPalette[static_cast<std::size_t>(i)]);
+    if (distance < best_distance) {
+      best = i;
+      best_distance = distance;
+    }
+  }
+  return best;
+}
+
+int nearest_cube_level(int component) {
+  int best = 0;
+  for (int i = 1; i < 6; ++i) {
+    if (std::abs(component - kCubeLevels[static_cast<std::size_t>(i)]) <
+        std::abs(component - kCubeLevels[static_cast<std::size_t>(best)])) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+int rgb_to_indexed(const Rgb& rgb) {
+  const int cube_index =
+      16 + 36 * nearest_cube_level(rgb.r) + 6 * nearest_cube_level(rgb.g) + nearest_cube_level(rgb.b);
+
+  const int average = (rgb.r + rgb.g + rgb.b) / 3;
+  const int gray_step = std::clamp((average - 8 + 5) / 10, 0, 23);
+  const int gray_index = 232 + gray_step;
+
+  return distance_squared(rgb, indexed_to_rgb(gray_index)) <
+                 distance_squared(rgb, indexed_to_rgb(cube_index))
+             ? gray_index
+             : cube_index;
+}
+
+// 256-color index -> nearest basic color, computed once for the whole table.
+const std::array<std::uint8_t, 256>& indexed_to_basic_table() {
+  static const std::array<std::uint8_t, 256> kTable = [] {
+    std::array<std::uint8_t, 256> table{};
+    for (int i = 0; i < 256; ++i) {
+      table[static_cast<std::size_t>(i)] =
+          static_cast<std::uint8_t>(i < 16 ? i : rgb_to_basic(indexed_to_rgb(i)));
+    }
+    return table;
+  }();
+  return kTable;
+}
+
+bool parse_number(const std::string& text, int max_value, int* result) {
+  if (text.empty() || text.size() > 3) {
+    return false;
+  }
+  int parsed = 0;
+  for (char ch : text) {
+    if (std::isdigit(static_cast<unsigned char>(ch)) == 0) {
+      return false;
+    }
+    parsed = parsed * 10 + (ch - '0');
+  }
+  if (parsed > max_value) {
+    return false;
+  }
+  *result = parsed;
+  return true;
+}
+
+bool parse_hex_rgb(const std::string& text, Rgb* rgb) {
+  if (text.size() != 7 || text[0] != '#') {
+    return false;
+  }
+  int components[3] = {0, 0, 0};
+  for (std::size_t i = 1; i < text.size(); ++i) {
+    const char ch = text[i];
+    int digit = 0;
+    if (ch >= '0' && ch <= '9') {
+      digit = ch - '0';
+    } else if (ch >= 'a' && ch <= 'f') {
+      digit = ch - 'a' + 10;
+    } else {
+      return false;
+    }
+    components[(i - 1) / 2] = components[(i - 1) / 2] * 16 + digit;
+  }
+  *rgb = Rgb{components[0], components[1], components[2]};
+  return true;
+}
+
+constexpr auto kBasicColors = adventure::parser::make_keyword_table<int>({
+    {"black", 0},         {"red", 1},          {"green", 2},          {"yellow", 3},
+    {"blue", 4},          {"magenta", 5},      {"cyan", 6},           {"white", 7},
+    {"bright_black", 8},  {"bright_red", 9},   {"bright_green", 10},  {"bright_yellow", 11},
+    {"bright_blue", 12},  {"bright_magenta", 13}, {"bright_cyan", 14}, {"bright_white", 15},
+});
+
+// Theme keys holding a string; `use_color` is parsed separately as a bool.
+constexpr auto kThemeStringFields = adventure::parser::make_keyword_table<std::string Theme::*>({
+    {"border_line", &Theme::border_line},
+    {"menu_selected_prefix", &Theme::menu_selected_prefix},
+    {"menu_unselected_prefix", &Theme::menu_unselected_prefix},
+    {"title_color", &Theme::title_color},
+    {"body_color", &Theme::body_color},
+    {"prompt_color", &Theme::prompt_color},
+    {"selected_color", &Theme::selected_color},
+    {"unselected_color", &Theme::unselected_color},
+    {"victory_color", &Theme::victory_color},
+    {"game_over_color", &Theme::game_over_color},
+    {"error_color", &Theme::error_color},
+});
+
+ColorSpec parse_color_spec(const std::string& color_name) {
+  ColorSpec spec;
+  const std::string name = to_lower(trim(color_name));
+  if (name.empty() || name == "none") {
+    return spec;
+  }
+  if (name == "default") {
+    spec.kind = ColorSpec::Kind::kDefault;
+    return spec;
+  }
+
+  if (const int* basic_index = kBasicColors.find(name)) {
+    spec.kind = ColorSpec::Kind::kBasic;
+    spec.index = *basic_index;
+    return spec;
+  }
+
+  if (name.rfind("color", 0) == 0 && parse_number(name.substr(5), 255, &spec.index)) {
+    spec.kind = ColorSpec::Kind::kIndexed;
+    return spec;
+  }
+
+  if (parse_hex_rgb(name, &spec.rgb)) {
+    spec.kind = ColorSpec::Kind::kRgb;
+    return spec;
+  }
+
+  return spec;
+}
+
+std::string basic_escape(int index) {
+  const int code = index < 8 ? 30 + index : 90 + (index - 8);
+  return "\033[" + std::to_string(code) + "m";
+}
+
+std::string indexed_escape(int index) { return "\033[38;5;" + std::to_string(index) + "m"; }
+
+std::string escape_for_spec(const ColorSpec& spec, ColorDepth depth) {
+  switch (spec.kind) {
+    case ColorSpec::Kind::kNone:
+      return "";
+    case ColorSpec::Kind::kDefault:
+      return "\033[39m";
+    case ColorSpec::Kind::kBasic:
+      return basic_escape(spec.index);
+    case ColorSpec::Kind::kIndexed:
+      if (depth == ColorDepth::kAnsi16) {
+        return basic_escape(indexed_to_basic_table()[static_cast<std::size_t>(spec.index)]);
+      }
+      return indexed_escape(spec.index);
+    case ColorSpec::Kind::kRgb:
+      if (depth == ColorDepth::kTrueColor) {
+        return "\033[38;2;" + std::to_string(spec.rgb.r) + ";" + std::to_string(spec.rgb.g) +
+               ";" + std::to_string(spec.rgb.b) + "m";
+      }
+      if (depth == ColorDepth::kAnsi256) {
+        return indexed_escape(rgb_to_indexed(spec.rgb));
+      }
+      return basic_escape(rgb_to_basic(spec.rgb));
+  }
+  return "";
+}
+
 }  // namespace
 
 Theme load_theme_from_file(const std::filesystem::path& theme_file, const Theme& base_theme) {
@@ -66,35 +297,15 @@ Theme load_theme_from_file(const std::filesystem::path& theme_file, const Theme&
       continue;
     }
 
-    const std::string key = to_lower(trim(trimmed.substr(0, eq)));
-    const std::string value = trim(trimmed.substr(eq + 1));
+    const std::string key = trim(trimmed.substr(0, eq));
+    std::string value = trim(trimmed.substr(eq + 1));
     if (key.empty()) {
       continue;
     }
 
-    if (key == "border_line") {
-      theme.border_line = value;
-    } else if (key == "menu_selected_prefix") {
-      theme.menu_selected_prefix = value;
-    } else if (key == "menu_unselected_prefix") {
-      theme.menu_unselected_prefix = value;
-    } else if (key == "title_color") {
-      theme.title_color = value;
-    } else if (key == "body_color") {
-      theme.body_color = value;
-    } else if (key == "prompt_color") {
-      theme.prompt_color = value;
-    } else if (key == "selected_color") {
-      theme.selected_color = value;
-    } else if (key == "unselected_color") {
-      theme.unselected_color = value;
-    } else if (key == "victory_color") {
-      theme.victory_color = value;
-    } else if (key == "game_over_color") {
-      theme.game_over_color = value;
-    } else if (key == "error_color") {
-      theme.error_color = value;
-    } else if (key == "use_color") {
+    if (std::string Theme::* const* field = kThemeStringFields.find(key)) {
+      theme.*(*field) = std::move(value);
+    } else if (adventure::parser::equals_ignore_case(key, "use_color")) {
       bool parsed = theme.use_color;
       if (parse_bool(value, &parsed)) {
         theme.use_color = parsed;
@@ -113,34 +324,59 @@ bool is_color_enabled_for_terminal() {
   return no_color == nullptr;
 }
 
-std::string ansi_color_code(const std::string& color_name) {
-  static const std::unordered_map<std::string, std::string> kCodes = {
-      {"default", "\033[39m"},
-      {"black", "\033[30m"},
-      {"red", "\033[31m"},
-      {"green", "\033[32m"},
-      {"yellow", "\033[33m"},
-      {"blue", "\033[34m"},
-      {"magenta", "\033[35m"},
-      {"cyan", "\033[36m"},
-      {"white", "\033[37m"},
-      {"bright_black", "\033[90m"},
-      {"bright_red", "\033[91m"},
-      {"bright_green", "\033[92m"},
-      {"bright_yellow", "\033[93m"},
-      {"bright_blue", "\033[94m"},
-      {"bright_magenta", "\033[95m"},
-      {"bright_cyan", "\033[96m"},
-      {"bright_white", "\033[97m"},
-      {"none", ""},
-      {"", ""},
-  };
+ColorDepth detect_color_depth() {
+  const char* colorterm = std::getenv("COLORTERM");
+  if (colorterm != nullptr) {
+    const std::string value = to_lower(colorterm);
+    if (value == "truecolor" || value == "24bit") {
+      return ColorDepth::kTrueColor;
+    }
+  }
+  const char* term = std::getenv("TERM");
+  if (term != nullptr && std::string(term).find("256color") != std::string::npos) {
+    return ColorDepth::kAnsi256;
+  }
+  return ColorDepth::kAnsi16;
+}
 
-  const auto it = kCodes.find(to_lower(trim(color_name)));
-  if (it == kCodes.end()) {
-    return "";
+CompiledColor compile_color(const std::string& color_name, bool use_color, ColorDepth depth) {
+  CompiledColor compiled;
+  if (!use_color) {
+    return compiled;
   }
-  return it->second;
+  compiled.prefix = ansi_color_code(color_name, depth);
+  if (!compiled.prefix.empty()) {
+    compiled.reset = "\033[0m";
+  }
+  return compiled;
+}
+
+CompiledTheme compile_theme(const Theme& theme, ColorDepth depth) {
+  CompiledTheme compiled;
+  compiled.depth = depth;
+  compiled.use_color = theme.use_color;
+
+  compiled.title = compile_color(theme.title_color, theme.use_color, depth);
+  compiled.body = compile_color(theme.body_color, theme.use_color, depth);
+  compiled.prompt = compile_color(theme.prompt_color, theme.use_color, depth);
+  compiled.selected = compile_color(theme.selected_color, theme.use_color, depth);
+  compiled.unselected = compile_color(theme.unselected_color, theme.use_color, depth);
+  compiled.victory = compile_color(theme.victory_color, theme.use_color, depth);
+  compiled.game_over = compile_color(theme.game_over_color, theme.use_color, depth);
+  compiled.error = compile_color(theme.error_color, theme.use_color, depth);
+
+  compiled.border_line = compiled.title.prefix + theme.border_line + compiled.title.reset;
+  compiled.selected_prefix = compiled.selected.prefix + theme.menu_selected_prefix + " ";
+  compiled.unselected_prefix = compiled.unselected.prefix + theme.menu_unselected_prefix + " ";
+  return compiled;
+}
+
+std::string ansi_color_code(const std::string& color_name) {
+  return ansi_color_code(color_name, ColorDepth::kAnsi16);
+}
+
+std::string ansi_color_code(const std::string& color_name, ColorDepth depth) {
+  return escape_for_spec(parse_color_spec(color_name), depth);
 }
 
 }  // namespace adventure::ui
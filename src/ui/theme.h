@@ -23,9 +23,46 @@ struct Theme {
   bool use_color = false;
 };
 
+enum class ColorDepth {
+  kAnsi16,
+  kAnsi256,
+  kTrueColor,
+};
+
+// Escape sequences for one theme color, resolved for a specific ColorDepth. Both strings are
+// empty when the color is disabled or unknown, so callers can emit them unconditionally.
+struct CompiledColor {
+  std::string prefix;
+  std::string reset;
+};
+
+// Render-ready form of a Theme: every color name is resolved to its escape sequence once and
+// the static strings (border line, menu prefixes) are stored already colorized.
+struct CompiledTheme {
+  ColorDepth depth = ColorDepth::kAnsi16;
+  bool use_color = false;
+
+  CompiledColor title;
+  CompiledColor body;
+  CompiledColor prompt;
+  CompiledColor selected;
+  CompiledColor unselected;
+  CompiledColor victory;
+  CompiledColor game_over;
+  CompiledColor error;
+
+  std::string border_line;        // title.prefix + border_line + title.reset
+  std::string selected_prefix;    // selected.prefix + menu_selected_prefix + " "
+  std::string unselected_prefix;  // unselected.prefix + menu_unselected_prefix + " "
+};
+
 Theme load_theme_from_file(const std::filesystem::path& theme_file, const Theme& base_theme);
+CompiledTheme compile_theme(const Theme& theme, ColorDepth depth);
+CompiledColor compile_color(const std::string& color_name, bool use_color, ColorDepth depth);
 bool is_color_enabled_for_terminal();
+ColorDepth detect_color_depth();
 std::string ansi_color_code(const std::string& color_name);
+std::string ansi_color_code(const std::string& color_name, ColorDepth depth);
 
 }  // namespace adventure::ui
 
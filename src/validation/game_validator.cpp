@@ -1,13 +1,21 @@
 #include "validation/game_validator.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 #include <string>
+#include <system_error>
 #include <unordered_set>
 #include <vector>
 
+#include "conditions/condition_program.h"
 #include "parser/parsed_level.h"
 #include "parser/tag_parser.h"
+#include "validation/level_graph.h"
+#include "validation/memory_lint.h"
+#include "validation/validation_cache.h"
 
 namespace adventure::validation {
 namespace {
@@ -30,6 +38,180 @@ bool file_exists(const std::filesystem::path& path) {
   return std::filesystem::exists(path) && std::filesystem::is_regular_file(path);
 }
 
+// Every regular file found by the one directory walk over the game root. Target checks inside the
+// root are answered from memory; only targets that escape the root still need a stat call.
+class GameFileIndex {
+ public:
+  explicit GameFileIndex(const std::filesystem::path& game_root)
+      : root_(game_root.lexically_normal()) {}
+
+  void add(const std::filesystem::path& normalized_path) {
+    files_.insert(normalized_path.string());
+  }
+
+  bool contains(const std::filesystem::path& normalized_path) const {
+    if (covers(normalized_path)) {
+      return files_.find(normalized_path.string()) != files_.end();
+    }
+    return file_exists(normalized_path);
+  }
+
+ private:
+  bool covers(const std::filesystem::path& path) const {
+    if (path.is_absolute() != root_.is_absolute()) {
+      return false;
+    }
+    const std::filesystem::path relative = path.lexically_relative(root_);
+    return !relative.empty() && *relative.begin() != "..";
+  }
+
+  std::filesystem::path root_;
+  std::unordered_set<std::string> files_;
+};
+
+std::filesystem::path resolve_target(const std::filesystem::path& level_path,
+                                     const std::string& target_text) {
+  const std::filesystem::path target = target_text;
+  return target.is_absolute() ? target.lexically_normal()
+                              : (level_path.parent_path() / target).lexically_normal();
+}
+
+// Runs every per-file check on one level's content. Everything the result depends on besides the
+// content itself is recorded in `targets`, so the result can be reused while those stay the same.
+CachedLevel check_level(const adventure::parser::TagParser& parser, const GameFileIndex& files,
+                        const std::filesystem::path& level_path, const std::string& content) {
+  CachedLevel level;
+
+  adventure::parser::ParsedLevelData data;
+  try {
+    std::istringstream input(content);
+    data = parser.parse(input);
+  } catch (const std::exception& ex) {
+    level.issues.push_back("Parse failure: " + std::string(ex.what()));
+    return level;
+  }
+  level.memory = collect_memory_accesses(data);
+
+  const adventure::parser::InputMode input_mode = adventure::parser::input_mode_of(data);
+  if (input_mode == adventure::parser::InputMode::kEndGame) {
+    const auto result_it = data.directives.find("result");
+    if (result_it == data.directives.end() ||
+        (result_it->second != "victory" && result_it->second != "game_over")) {
+      level.issues.push_back("Endgame level must define `result: victory|game_over`.");
+    } else {
+      level.kind = result_it->second == "victory" ? LevelKind::kVictory : LevelKind::kGameOver;
+    }
+    return level;
+  }
+
+  const auto add_target = [&](const std::string& target_text, const char* what) {
+    const std::filesystem::path resolved = resolve_target(level_path, target_text);
+    const bool exists = files.contains(resolved);
+    if (!exists) {
+      level.issues.push_back(std::string("Missing ") + what + " target `" + target_text + "`.");
+    }
+    level.targets.push_back({resolved.string(), exists});
+  };
+
+  std::unordered_set<std::string> option_ids;
+  if (input_mode == adventure::parser::InputMode::kInput) {
+    if (data.input_rules.empty()) {
+      level.issues.push_back("Input level has no INPUT_RULES.");
+      return level;
+    }
+    for (std::size_t i = 0; i < data.input_rules.size(); ++i) {
+      const std::string rule_id = resolve_rule_id(data.input_rules[i], i);
+      if (!option_ids.insert(rule_id).second) {
+        level.issues.push_back("Duplicate input rule id: `" + rule_id + "`.");
+      }
+      add_target(data.input_rules[i].target, "input rule");
+    }
+  } else {
+    if (data.options.empty()) {
+      level.issues.push_back("Choice level has no options.");
+      return level;
+    }
+    for (std::size_t i = 0; i < data.options.size(); ++i) {
+      const std::string option_id = resolve_option_id(data.options[i], i);
+      if (!option_ids.insert(option_id).second) {
+        level.issues.push_back("Duplicate option id: `" + option_id + "`.");
+      }
+      add_target(data.options[i].target, "option");
+    }
+  }
+
+  for (const auto& condition : data.option_conditions) {
+    if (option_ids.find(condition.option_id) == option_ids.end()) {
+      level.issues.push_back("OPTION_CONDITIONS references unknown option id `" +
+                             condition.option_id + "`.");
+    }
+    adventure::conditions::ConditionProgram program;
+    std::string error;
+    if (!condition.expression.empty() &&
+        !adventure::conditions::compile_expression(condition.expression, &program, &error)) {
+      level.issues.push_back("OPTION_CONDITIONS for `" + condition.option_id + "`: " + error);
+    }
+  }
+
+  for (const auto& effect : data.option_effects) {
+    if (option_ids.find(effect.option_id) == option_ids.end()) {
+      level.issues.push_back("OPTION_EFFECTS references unknown option id `" + effect.option_id +
+                             "`.");
+    }
+  }
+  return level;
+}
+
+bool read_file(const std::filesystem::path& path, std::string* content) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+  std::ostringstream buffer;
+  buffer << file.rdbuf();
+  *content = buffer.str();
+  return true;
+}
+
+// A cached result stays valid only while each referenced target still exists (or is still
+// missing) exactly as it did when the level was checked.
+bool targets_unchanged(const CachedLevel& level, const GameFileIndex& files) {
+  return std::all_of(level.targets.begin(), level.targets.end(), [&](const CachedTarget& target) {
+    return files.contains(target.path) == target.exists;
+  });
+}
+
+void report_graph_issues(const LevelGraph& graph, const std::filesystem::path& start_file,
+                         ValidationReport* report) {
+  if (graph.start == LevelGraph::kNoLevel) {
+    return;
+  }
+
+  const GraphAnalysis analysis = analyze_level_graph(graph);
+  for (const std::uint32_t level : analysis.unreachable) {
+    report->issues.push_back(
+        {graph.level_paths[level], "Level is unreachable from start.level."});
+  }
+
+  for (const auto& cycle : analysis.trap_cycles) {
+    std::string members;
+    for (std::size_t i = 0; i < cycle.size() && i < 5; ++i) {
+      members += (i == 0 ? "" : ", ") +
+                 std::filesystem::path(graph.level_paths[cycle[i]]).filename().string();
+    }
+    if (cycle.size() > 5) {
+      members += ", ... (" + std::to_string(cycle.size()) + " levels)";
+    }
+    report->issues.push_back({graph.level_paths[cycle.front()],
+                              "Trap cycle: no path to an endgame or other level leaves [" +
+                                  members + "]."});
+  }
+
+  if (!analysis.victory_reachable) {
+    report->issues.push_back({start_file, "No `result: victory` endgame is reachable."});
+  }
+}
+
 }  // namespace
 
 ValidationReport validate_game(const std::filesystem::path& game_root) {
@@ -37,105 +219,95 @@ ValidationReport validate_game(const std::filesystem::path& game_root) {
   adventure::parser::TagParser parser;
 
   std::vector<std::filesystem::path> levels;
+  GameFileIndex files(game_root);
   for (const auto& entry : std::filesystem::recursive_directory_iterator(game_root)) {
-    if (!entry.is_regular_file() || entry.path().extension() != ".level") {
+    if (!entry.is_regular_file()) {
       continue;
     }
-    levels.push_back(entry.path().lexically_normal());
+    const std::filesystem::path path = entry.path().lexically_normal();
+    files.add(path);
+    if (path.extension() == ".level") {
+      levels.push_back(path);
+    }
   }
 
   std::sort(levels.begin(), levels.end());
 
+  ValidationCache previous = load_validation_cache(game_root);
+  ValidationCache current;
+  current.reserve(levels.size());
+  bool cache_changed = previous.size() != levels.size();
+
+  LevelGraphBuilder graph_builder;
+  MemoryLint memory_lint;
   for (const auto& level_path : levels) {
     ++report.checked_files;
+    const std::string key = level_path.string();
 
-    adventure::parser::ParsedLevelData data;
-    try {
-      data = parser.parse_file(level_path);
-    } catch (const std::exception& ex) {
-      report.issues.push_back({level_path, "Parse failure: " + std::string(ex.what())});
-      continue;
-    }
+    std::error_code error;
+    const std::uintmax_t size = std::filesystem::file_size(level_path, error);
+    const std::int64_t mtime = static_cast<std::int64_t>(
+        std::filesystem::last_write_time(level_path, error).time_since_epoch().count());
 
-    const std::string input_mode =
-        (data.directives.find("input_mode") != data.directives.end())
-            ? data.directives.at("input_mode")
-            : "choice";
-    const bool is_endgame = input_mode == "endgame";
-
-    if (is_endgame) {
-      const auto result_it = data.directives.find("result");
-      if (result_it == data.directives.end() ||
-          (result_it->second != "victory" && result_it->second != "game_over")) {
-        report.issues.push_back(
-            {level_path, "Endgame level must define `result: victory|game_over`."});
+    CachedLevel level;
+    bool reusable = false;
+    std::string content;
+    bool content_loaded = false;
+    const auto cached_it = previous.find(key);
+    if (cached_it != previous.end()) {
+      // Size and mtime catch the common unchanged case without reading; a touched but identical
+      // file is recognised by its content hash.
+      level = std::move(cached_it->second);
+      reusable = level.size == size && level.mtime == mtime;
+      if (!reusable && level.size == size) {
+        content_loaded = read_file(level_path, &content);
+        reusable = content_loaded && hash_level_content(content) == level.content_hash;
       }
-      continue;
+      reusable = reusable && targets_unchanged(level, files);
     }
 
-    std::unordered_set<std::string> option_ids;
-    if (input_mode == "input") {
-      if (data.input_rules.empty()) {
-        report.issues.push_back({level_path, "Input level has no INPUT_RULES."});
-        continue;
-      }
-      for (std::size_t i = 0; i < data.input_rules.size(); ++i) {
-        const std::string rule_id = resolve_rule_id(data.input_rules[i], i);
-        if (!option_ids.insert(rule_id).second) {
-          report.issues.push_back({level_path, "Duplicate input rule id: `" + rule_id + "`."});
-        }
-
-        const std::filesystem::path target = data.input_rules[i].target;
-        const std::filesystem::path resolved =
-            target.is_absolute() ? target.lexically_normal()
-                                 : (level_path.parent_path() / target).lexically_normal();
-        if (!file_exists(resolved)) {
-          report.issues.push_back(
-              {level_path, "Missing input rule target `" + data.input_rules[i].target + "`."});
-        }
-      }
-    } else {
-      if (data.options.empty()) {
-        report.issues.push_back({level_path, "Choice level has no options."});
-        continue;
-      }
-      for (std::size_t i = 0; i < data.options.size(); ++i) {
-        const std::string option_id = resolve_option_id(data.options[i], i);
-        if (!option_ids.insert(option_id).second) {
-          report.issues.push_back({level_path, "Duplicate option id: `" + option_id + "`."});
-        }
-
-        const std::filesystem::path target = data.options[i].target;
-        const std::filesystem::path resolved =
-            target.is_absolute() ? target.lexically_normal()
-                                 : (level_path.parent_path() / target).lexically_normal();
-        if (!file_exists(resolved)) {
-          report.issues.push_back(
-              {level_path, "Missing option target `" + data.options[i].target + "`."});
-        }
+    if (!reusable) {
+      if (!content_loaded && !read_file(level_path, &content)) {
+        content.clear();
+        level = CachedLevel{};
+        level.issues.push_back("Parse failure: Could not open level file: " + key);
+      } else {
+        level = check_level(parser, files, level_path, content);
       }
+      level.content_hash = hash_level_content(content);
+      ++report.rechecked_files;
     }
-
-    for (const auto& condition : data.option_conditions) {
-      if (option_ids.find(condition.option_id) == option_ids.end()) {
-        report.issues.push_back(
-            {level_path, "OPTION_CONDITIONS references unknown option id `" + condition.option_id + "`."});
-      }
+    if (!reusable || level.size != size || level.mtime != mtime) {
+      level.size = size;
+      level.mtime = mtime;
+      cache_changed = true;
     }
 
-    for (const auto& effect : data.option_effects) {
-      if (option_ids.find(effect.option_id) == option_ids.end()) {
-        report.issues.push_back(
-            {level_path, "OPTION_EFFECTS references unknown option id `" + effect.option_id + "`."});
-      }
+    const std::uint32_t level_id = graph_builder.add_level(key, level.kind);
+    for (const CachedTarget& target : level.targets) {
+      graph_builder.add_edge(level_id, target.path);
+    }
+    memory_lint.add_level(level_id, level.memory);
+    for (const std::string& issue : level.issues) {
+      report.issues.push_back({level_path, issue});
     }
+    current.emplace(key, std::move(level));
+  }
+
+  if (cache_changed) {
+    save_validation_cache(game_root, current);
   }
 
   const std::filesystem::path start_file = (game_root / "start.level").lexically_normal();
-  if (!file_exists(start_file)) {
+  if (!files.contains(start_file)) {
     report.issues.push_back({start_file, "Game root must contain start.level."});
   }
 
+  report_graph_issues(graph_builder.build(start_file.string()), start_file, &report);
+  for (const MemoryLintFinding& finding : memory_lint.findings()) {
+    report.issues.push_back({levels[finding.level], finding.message});
+  }
+
   return report;
 }
 
@@ -14,6 +14,7 @@ struct ValidationIssue {
 
 struct ValidationReport {
   std::size_t checked_files = 0;
+  std::size_t rechecked_files = 0;  // files not answered from the validation cache
   std::vector<ValidationIssue> issues;
 };
 
@@ -0,0 +1,200 @@
+#include "validation/level_graph.h"
+
+#include <algorithm>
+
+namespace adventure::validation {
+namespace {
+
+std::vector<bool> find_reachable(const LevelGraph& graph) {
+  std::vector<bool> reachable(graph.level_count(), false);
+  if (graph.start == LevelGraph::kNoLevel) {
+    return reachable;
+  }
+
+  std::vector<std::uint32_t> queue;
+  queue.reserve(graph.level_count());
+  queue.push_back(graph.start);
+  reachable[graph.start] = true;
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    const std::uint32_t level = queue[head];
+    for (std::uint32_t e = graph.edge_offsets[level]; e < graph.edge_offsets[level + 1]; ++e) {
+      const std::uint32_t next = graph.edge_targets[e];
+      if (!reachable[next]) {
+        reachable[next] = true;
+        queue.push_back(next);
+      }
+    }
+  }
+  return reachable;
+}
+
+// Iterative Tarjan so deep level chains cannot overflow the call stack. Returns the component
+// id of every visited level (kNoLevel for levels that were not visited).
+std::vector<std::uint32_t> strongly_connected_components(const LevelGraph& graph,
+                                                         const std::vector<bool>& visit,
+                                                         std::uint32_t* component_count) {
+  const std::size_t count = graph.level_count();
+  std::vector<std::uint32_t> index(count, LevelGraph::kNoLevel);
+  std::vector<std::uint32_t> low_link(count, 0);
+  std::vector<std::uint32_t> component(count, LevelGraph::kNoLevel);
+  std::vector<bool> on_stack(count, false);
+  std::vector<std::uint32_t> scc_stack;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> call_stack;  // (level, next edge)
+  std::uint32_t next_index = 0;
+  *component_count = 0;
+
+  for (std::uint32_t root = 0; root < count; ++root) {
+    if (!visit[root] || index[root] != LevelGraph::kNoLevel) {
+      continue;
+    }
+
+    call_stack.push_back({root, graph.edge_offsets[root]});
+    index[root] = low_link[root] = next_index++;
+    scc_stack.push_back(root);
+    on_stack[root] = true;
+
+    while (!call_stack.empty()) {
+      auto& [level, edge] = call_stack.back();
+      if (edge < graph.edge_offsets[level + 1]) {
+        const std::uint32_t next = graph.edge_targets[edge++];
+        if (index[next] == LevelGraph::kNoLevel) {
+          index[next] = low_link[next] = next_index++;
+          scc_stack.push_back(next);
+          on_stack[next] = true;
+          call_stack.push_back({next, graph.edge_offsets[next]});
+        } else if (on_stack[next]) {
+          low_link[level] = std::min(low_link[level], index[next]);
+        }
+        continue;
+      }
+
+      const std::uint32_t finished = level;
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        const std::uint32_t parent = call_stack.back().first;
+        low_link[parent] = std::min(low_link[parent], low_link[finished]);
+      }
+      if (low_link[finished] == index[finished]) {
+        std::uint32_t member = 0;
+        do {
+          member = scc_stack.back();
+          scc_stack.pop_back();
+          on_stack[member] = false;
+          component[member] = *component_count;
+        } while (member != finished);
+        ++*component_count;
+      }
+    }
+  }
+  return component;
+}
+
+}  // namespace
+
+std::uint32_t LevelGraphBuilder::add_level(std::string path, LevelKind kind) {
+  const auto it = ids_.find(path);
+  if (it != ids_.end()) {
+    kinds_[it->second] = kind;
+    return it->second;
+  }
+  const std::uint32_t id = static_cast<std::uint32_t>(level_paths_.size());
+  ids_.emplace(path, id);
+  level_paths_.push_back(std::move(path));
+  kinds_.push_back(kind);
+  return id;
+}
+
+void LevelGraphBuilder::add_edge(std::uint32_t from, std::string target_path) {
+  pending_edges_.push_back({from, std::move(target_path)});
+}
+
+LevelGraph LevelGraphBuilder::build(const std::string& start_path) const {
+  LevelGraph graph;
+  graph.level_paths = level_paths_;
+  graph.kinds = kinds_;
+
+  const auto start_it = ids_.find(start_path);
+  if (start_it != ids_.end()) {
+    graph.start = start_it->second;
+  }
+
+  // Counting sort of resolved edges by source level into the offset/target arrays.
+  std::vector<std::uint32_t> resolved(pending_edges_.size(), LevelGraph::kNoLevel);
+  graph.edge_offsets.assign(level_paths_.size() + 1, 0);
+  for (std::size_t i = 0; i < pending_edges_.size(); ++i) {
+    const auto it = ids_.find(pending_edges_[i].second);
+    if (it == ids_.end()) {
+      continue;
+    }
+    resolved[i] = it->second;
+    ++graph.edge_offsets[pending_edges_[i].first + 1];
+  }
+  for (std::size_t level = 0; level < level_paths_.size(); ++level) {
+    graph.edge_offsets[level + 1] += graph.edge_offsets[level];
+  }
+
+  graph.edge_targets.resize(graph.edge_offsets.back());
+  std::vector<std::uint32_t> cursor(graph.edge_offsets.begin(), graph.edge_offsets.end() - 1);
+  for (std::size_t i = 0; i < pending_edges_.size(); ++i) {
+    if (resolved[i] != LevelGraph::kNoLevel) {
+      graph.edge_targets[cursor[pending_edges_[i].first]++] = resolved[i];
+    }
+  }
+  return graph;
+}
+
+GraphAnalysis analyze_level_graph(const LevelGraph& graph) {
+  GraphAnalysis analysis;
+  const std::vector<bool> reachable = find_reachable(graph);
+
+  for (std::uint32_t level = 0; level < graph.level_count(); ++level) {
+    if (!reachable[level]) {
+      analysis.unreachable.push_back(level);
+    } else if (graph.kinds[level] == LevelKind::kVictory) {
+      analysis.victory_reachable = true;
+    }
+  }
+
+  std::uint32_t component_count = 0;
+  const std::vector<std::uint32_t> component =
+      strongly_connected_components(graph, reachable, &component_count);
+
+  std::vector<std::uint32_t> component_size(component_count, 0);
+  std::vector<bool> has_exit(component_count, false);
+  std::vector<bool> has_endgame(component_count, false);
+  std::vector<bool> has_internal_edge(component_count, false);
+  for (std::uint32_t level = 0; level < graph.level_count(); ++level) {
+    if (!reachable[level]) {
+      continue;
+    }
+    const std::uint32_t id = component[level];
+    ++component_size[id];
+    if (graph.kinds[level] != LevelKind::kPlayable) {
+      has_endgame[id] = true;
+    }
+    for (std::uint32_t e = graph.edge_offsets[level]; e < graph.edge_offsets[level + 1]; ++e) {
+      if (component[graph.edge_targets[e]] == id) {
+        has_internal_edge[id] = true;
+      } else {
+        has_exit[id] = true;
+      }
+    }
+  }
+
+  std::vector<std::uint32_t> trap_slot(component_count, LevelGraph::kNoLevel);
+  for (std::uint32_t id = 0; id < component_count; ++id) {
+    if (!has_exit[id] && !has_endgame[id] && has_internal_edge[id]) {
+      trap_slot[id] = static_cast<std::uint32_t>(analysis.trap_cycles.size());
+      analysis.trap_cycles.emplace_back();
+      analysis.trap_cycles.back().reserve(component_size[id]);
+    }
+  }
+  for (std::uint32_t level = 0; level < graph.level_count(); ++level) {
+    if (reachable[level] && trap_slot[component[level]] != LevelGraph::kNoLevel) {
+      analysis.trap_cycles[trap_slot[component[level]]].push_back(level);
+    }
+  }
+  return analysis;
+}
+
+}  // namespace adventure::validation
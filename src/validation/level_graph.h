@@ -0,0 +1,59 @@
+#ifndef CLI_ADVENTURE_VALIDATION_LEVEL_GRAPH_H_
+#define CLI_ADVENTURE_VALIDATION_LEVEL_GRAPH_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace adventure::validation {
+
+enum class LevelKind {
+  kPlayable,
+  kVictory,
+  kGameOver,
+};
+
+// Level transition graph in compressed adjacency form: the successors of level `i` are
+// `edge_targets[edge_offsets[i] .. edge_offsets[i + 1])`.
+struct LevelGraph {
+  static constexpr std::uint32_t kNoLevel = UINT32_MAX;
+
+  std::vector<std::string> level_paths;
+  std::vector<LevelKind> kinds;
+  std::vector<std::uint32_t> edge_offsets;
+  std::vector<std::uint32_t> edge_targets;
+  std::uint32_t start = kNoLevel;
+
+  std::size_t level_count() const { return level_paths.size(); }
+};
+
+// Collects levels and their target paths in any order, then resolves targets to level ids.
+// Targets that do not name a registered level are dropped; the validator reports those.
+class LevelGraphBuilder {
+ public:
+  std::uint32_t add_level(std::string path, LevelKind kind);
+  void add_edge(std::uint32_t from, std::string target_path);
+  LevelGraph build(const std::string& start_path) const;
+
+ private:
+  std::vector<std::string> level_paths_;
+  std::vector<LevelKind> kinds_;
+  std::unordered_map<std::string, std::uint32_t> ids_;
+  std::vector<std::pair<std::uint32_t, std::string>> pending_edges_;
+};
+
+struct GraphAnalysis {
+  std::vector<std::uint32_t> unreachable;
+  // Strongly connected sets of non-endgame levels with no transition leading out of the set.
+  std::vector<std::vector<std::uint32_t>> trap_cycles;
+  bool victory_reachable = false;
+};
+
+// BFS from the start level plus Tarjan's SCC over the reachable part; O(levels + edges).
+GraphAnalysis analyze_level_graph(const LevelGraph& graph);
+
+}  // namespace adventure::validation
+
+#endif  // CLI_ADVENTURE_VALIDATION_LEVEL_GRAPH_H_
@@ -0,0 +1,247 @@
+#include "validation/memory_footprint.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "context/game_context.h"
+#include "parser/tag_parser.h"
+#include "validation/memory_lint.h"
+
+namespace adventure::validation {
+namespace {
+
+// Hash nodes carry the value, a next pointer and (for string keys) the cached hash.
+constexpr std::size_t kHashNodeOverhead = sizeof(void*) + sizeof(std::size_t);
+
+std::size_t string_heap(const std::string& text) {
+  const char* data = text.data();
+  const char* self = reinterpret_cast<const char*>(&text);
+  if (data >= self && data < self + sizeof(std::string)) {
+    return 0;  // short-string buffer inside the object
+  }
+  return text.capacity() + 1;
+}
+
+std::size_t heap_for_length(std::size_t length) {
+  const std::string probe(length, 'x');
+  return string_heap(probe);
+}
+
+void add_fields(const adventure::parser::FieldMap& fields, ParsedBytes* bytes) {
+  bytes->maps += fields.capacity() * sizeof(adventure::parser::FieldMap::value_type);
+  for (const auto& [key, value] : fields) {
+    bytes->strings += string_heap(key) + string_heap(value);
+  }
+}
+
+void add_lines(const adventure::parser::TextLines& lines, ParsedBytes* bytes) {
+  bytes->vectors += lines.span_capacity() * adventure::parser::TextLines::kSpanBytes;
+  bytes->strings += string_heap(lines.text());
+}
+
+// Streamed content stays in the level file; only its path and byte ranges are resident.
+void add_streamed(const adventure::parser::StreamedContent& content, ParsedBytes* bytes) {
+  bytes->vectors += content.ranges.capacity() * sizeof(adventure::parser::ContentRange);
+  bytes->strings += string_heap(content.path);
+}
+
+template <typename T>
+void add_vector(const std::vector<T>& items, ParsedBytes* bytes) {
+  bytes->vectors += items.capacity() * sizeof(T);
+}
+
+void add_strings(const std::vector<std::string>& items, ParsedBytes* bytes) {
+  add_vector(items, bytes);
+  for (const auto& item : items) {
+    bytes->strings += string_heap(item);
+  }
+}
+
+void add_mutations(const std::vector<adventure::parser::MemoryMutation>& mutations,
+                   ParsedBytes* bytes) {
+  add_vector(mutations, bytes);
+  for (const auto& mutation : mutations) {
+    bytes->strings += string_heap(mutation.key) + string_heap(mutation.value);
+  }
+}
+
+std::vector<std::filesystem::path> find_levels(const std::filesystem::path& game_root) {
+  std::vector<std::filesystem::path> levels;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(game_root)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".level") {
+      levels.push_back(entry.path().lexically_normal());
+    }
+  }
+  std::sort(levels.begin(), levels.end());
+  return levels;
+}
+
+// Interned symbol table plus what a session can hold: one flag node per flag that is ever set and
+// one value node per assigned key, holding its longest assigned string, plus one number node per
+// key that add_value/sub_value changes.
+struct SymbolCollector {
+  std::unordered_set<std::string> symbols;
+  std::unordered_set<std::string> flags;
+  std::unordered_map<std::string, std::size_t> longest_value;
+  std::unordered_set<std::string> numbers;
+
+  void add(const MemoryAccess& access) {
+    symbols.insert(access.key);
+    switch (access.kind) {
+      case MemoryAccess::Kind::kSetFlag:
+        flags.insert(access.key);
+        break;
+      case MemoryAccess::Kind::kReadFlag:
+        break;
+      case MemoryAccess::Kind::kSetValue: {
+        symbols.insert(access.value);
+        std::size_t& longest = longest_value[access.key];
+        longest = std::max(longest, access.value.size());
+        break;
+      }
+      case MemoryAccess::Kind::kReadValue:
+      case MemoryAccess::Kind::kCompareValue:
+        symbols.insert(access.value);
+        break;
+      case MemoryAccess::Kind::kAddNumber:
+        numbers.insert(access.key);
+        break;
+    }
+  }
+};
+
+}  // namespace
+
+ParsedBytes& ParsedBytes::operator+=(const ParsedBytes& other) {
+  objects += other.objects;
+  strings += other.strings;
+  vectors += other.vectors;
+  maps += other.maps;
+  return *this;
+}
+
+ParsedBytes measure_parsed_level(const adventure::parser::ParsedLevelData& data) {
+  ParsedBytes bytes;
+  bytes.objects = sizeof(adventure::parser::ParsedLevelData);
+  add_fields(data.header, &bytes);
+  add_fields(data.directives, &bytes);
+  add_lines(data.content_lines, &bytes);
+  add_streamed(data.streamed_content, &bytes);
+
+  add_vector(data.options, &bytes);
+  for (const auto& option : data.options) {
+    bytes.strings += string_heap(option.id) + string_heap(option.text) + string_heap(option.target);
+  }
+  add_vector(data.input_rules, &bytes);
+  for (const auto& rule : data.input_rules) {
+    bytes.strings += string_heap(rule.id) + string_heap(rule.pattern) + string_heap(rule.target);
+  }
+  add_mutations(data.on_enter_memory, &bytes);
+
+  add_vector(data.option_conditions, &bytes);
+  for (const auto& condition : data.option_conditions) {
+    bytes.strings += string_heap(condition.option_id);
+    add_strings(condition.required_flags, &bytes);
+    add_strings(condition.forbidden_flags, &bytes);
+    add_strings(condition.required_missing_values, &bytes);
+    add_vector(condition.required_values, &bytes);
+    add_vector(condition.number_bounds, &bytes);
+    for (const auto& bound : condition.number_bounds) {
+      bytes.strings += string_heap(bound.key);
+    }
+    for (const auto& [key, value] : condition.required_values) {
+      bytes.strings += string_heap(key) + string_heap(value);
+    }
+  }
+  add_vector(data.option_effects, &bytes);
+  for (const auto& effect : data.option_effects) {
+    bytes.strings += string_heap(effect.option_id);
+    add_mutations(effect.mutations, &bytes);
+  }
+  return bytes;
+}
+
+MemoryFootprintReport measure_game_footprint(const std::filesystem::path& game_root) {
+  MemoryFootprintReport report;
+  const adventure::parser::TagParser parser;
+  SymbolCollector collector;
+  std::unordered_set<std::string> art_files;
+  std::size_t longest_level_path = 0;
+
+  for (const auto& level_path : find_levels(game_root)) {
+    adventure::parser::ParsedLevelData data;
+    try {
+      data = parser.parse_file(level_path);
+    } catch (const std::exception&) {
+      continue;
+    }
+
+    LevelFootprint level;
+    level.level = level_path.lexically_relative(game_root);
+    level.parsed = measure_parsed_level(data);
+
+    const auto art_it = data.header.find("ascii_art");
+    if (art_it != data.header.end() && !art_it->second.empty()) {
+      const std::filesystem::path art_path =
+          (level_path.parent_path() / art_it->second).lexically_normal();
+      std::error_code error;
+      const std::uintmax_t size = std::filesystem::file_size(art_path, error);
+      if (!error) {
+        level.ascii_art = static_cast<std::size_t>(size);
+        art_files.insert(art_path.string());
+      }
+    }
+
+    for (const MemoryAccess& access : collect_memory_accesses(data)) {
+      collector.add(access);
+    }
+    longest_level_path = std::max(longest_level_path, level_path.string().size());
+
+    report.parsed += level.parsed;
+    report.ascii_art += level.ascii_art;
+    report.levels.push_back(std::move(level));
+  }
+  report.ascii_art_files = art_files.size();
+
+  report.symbol_count = collector.symbols.size();
+  report.symbols = collector.symbols.bucket_count() * sizeof(void*);
+  for (const auto& symbol : collector.symbols) {
+    report.symbols += sizeof(std::string) + kHashNodeOverhead + string_heap(symbol);
+  }
+
+  // Directory and level path are the only strings a fresh session owns.
+  const std::size_t path_heap = heap_for_length(longest_level_path);
+  report.context_initial = sizeof(adventure::context::GameContext) + 2 * path_heap;
+  report.context_peak = report.context_initial;
+  for (const auto& flag : collector.flags) {
+    report.context_peak +=
+        sizeof(void*) + sizeof(std::string) + kHashNodeOverhead + string_heap(flag);
+  }
+  for (const auto& [key, longest] : collector.longest_value) {
+    report.context_peak += sizeof(void*) + sizeof(std::pair<const std::string, std::string>) +
+                           kHashNodeOverhead + string_heap(key) +
+                           heap_for_length(longest);
+  }
+  for (const auto& key : collector.numbers) {
+    report.context_peak += sizeof(void*) + sizeof(std::pair<const std::string, std::int64_t>) +
+                           kHashNodeOverhead + string_heap(key);
+  }
+  // The symbol-indexed copy of flags and values that compiled conditions read, at most one bit
+  // and one value slot (text symbol, number tag and int64) per game symbol.
+  report.context_peak += (report.symbol_count + 63) / 64 * sizeof(std::uint64_t) +
+                         report.symbol_count * 2 * sizeof(std::int64_t);
+
+  std::sort(report.levels.begin(), report.levels.end(),
+            [](const LevelFootprint& left, const LevelFootprint& right) {
+              return left.total() != right.total() ? left.total() > right.total()
+                                                   : left.level < right.level;
+            });
+  return report;
+}
+
+}  // namespace adventure::validation
@@ -0,0 +1,56 @@
+#ifndef CLI_ADVENTURE_VALIDATION_MEMORY_FOOTPRINT_H_
+#define CLI_ADVENTURE_VALIDATION_MEMORY_FOOTPRINT_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <vector>
+
+#include "parser/parsed_level.h"
+
+namespace adventure::validation {
+
+// Resident bytes of one ParsedLevelData by container kind. String bytes are heap buffers only
+// (short strings live inside their owner, content lines share one text buffer); vector bytes are
+// element storage at capacity; map bytes are the header/directive field entries.
+struct ParsedBytes {
+  std::size_t objects = 0;  // sizeof(ParsedLevelData)
+  std::size_t strings = 0;
+  std::size_t vectors = 0;
+  std::size_t maps = 0;
+
+  std::size_t total() const { return objects + strings + vectors + maps; }
+  ParsedBytes& operator+=(const ParsedBytes& other);
+};
+
+struct LevelFootprint {
+  std::filesystem::path level;  // relative to the game root
+  ParsedBytes parsed;
+  std::size_t ascii_art = 0;  // art text copied into the level's cached scene
+
+  std::size_t total() const { return parsed.total() + ascii_art; }
+};
+
+struct MemoryFootprintReport {
+  std::vector<LevelFootprint> levels;  // largest first
+  ParsedBytes parsed;
+  std::size_t ascii_art = 0;
+  std::size_t ascii_art_files = 0;  // distinct art files referenced
+  std::size_t symbol_count = 0;     // distinct memory flag/value keys and assigned values
+  std::size_t symbols = 0;          // bytes to intern them once
+  std::size_t context_initial = 0;  // GameContext at session start
+  std::size_t context_peak = 0;     // GameContext with every flag and value set
+
+  // Game-wide resident cost: loaded levels, art, symbols and one session at its peak.
+  std::size_t total() const { return parsed.total() + ascii_art + symbols + context_peak; }
+};
+
+ParsedBytes measure_parsed_level(const adventure::parser::ParsedLevelData& data);
+
+// Parses every `.level` file under `game_root` (unparsable files are skipped; --validate reports
+// them) and estimates what the engine keeps resident for the game. Sizes follow the standard
+// library's actual capacities and node layout, so they are estimates, not allocator totals.
+MemoryFootprintReport measure_game_footprint(const std::filesystem::path& game_root);
+
+}  // namespace adventure::validation
+
+#endif  // CLI_ADVENTURE_VALIDATION_MEMORY_FOOTPRINT_H_
@@ -0,0 +1,209 @@
+#include "validation/memory_lint.h"
+
+#include <cstdint>
+
+#include "conditions/condition_program.h"
+#include "parser/integer_literal.h"
+
+namespace adventure::validation {
+namespace {
+
+using adventure::parser::MemoryMutation;
+
+// Numbers are compared by value, so `7` and `07` name the same one.
+std::string canonical_value(const std::string& value) {
+  std::int64_t number = 0;
+  return adventure::parser::parse_integer(value, &number) ? std::to_string(number) : value;
+}
+
+void collect_mutations(const std::vector<MemoryMutation>& mutations,
+                       std::vector<MemoryAccess>* accesses) {
+  for (const MemoryMutation& mutation : mutations) {
+    switch (mutation.kind) {
+      case MemoryMutation::Kind::kAddFlag:
+        accesses->push_back({MemoryAccess::Kind::kSetFlag, mutation.key, ""});
+        break;
+      case MemoryMutation::Kind::kSetValue:
+        accesses->push_back({MemoryAccess::Kind::kSetValue, mutation.key, mutation.value});
+        break;
+      case MemoryMutation::Kind::kSetNumber:
+        accesses->push_back(
+            {MemoryAccess::Kind::kSetValue, mutation.key, std::to_string(mutation.number)});
+        break;
+      case MemoryMutation::Kind::kAddNumber:
+        accesses->push_back({MemoryAccess::Kind::kAddNumber, mutation.key, ""});
+        break;
+      case MemoryMutation::Kind::kClearFlag:
+      case MemoryMutation::Kind::kEraseValue:
+        break;
+    }
+  }
+}
+
+// Expressions that do not compile are reported by the validator and read nothing here.
+void collect_expression(const std::string& expression, std::vector<MemoryAccess>* accesses) {
+  adventure::conditions::ConditionProgram program;
+  std::string error;
+  if (expression.empty() ||
+      !adventure::conditions::compile_expression(expression, &program, &error)) {
+    return;
+  }
+  const adventure::context::MemorySymbols& symbols = adventure::context::memory_symbols();
+  for (const adventure::conditions::Instruction& instruction : program.code()) {
+    switch (instruction.op) {
+      case adventure::conditions::OpCode::kFlag:
+        accesses->push_back(
+            {MemoryAccess::Kind::kReadFlag, std::string(symbols.name(instruction.a)), ""});
+        break;
+      case adventure::conditions::OpCode::kHasValue:
+      case adventure::conditions::OpCode::kNumberLess:
+      case adventure::conditions::OpCode::kNumberLessEqual:
+      case adventure::conditions::OpCode::kNumberGreater:
+      case adventure::conditions::OpCode::kNumberGreaterEqual:
+        accesses->push_back(
+            {MemoryAccess::Kind::kReadValue, std::string(symbols.name(instruction.a)), ""});
+        break;
+      case adventure::conditions::OpCode::kValueEquals:
+        accesses->push_back({MemoryAccess::Kind::kCompareValue,
+                             std::string(symbols.name(instruction.a)),
+                             std::string(symbols.name(instruction.b))});
+        break;
+      case adventure::conditions::OpCode::kNumberEquals:
+        accesses->push_back({MemoryAccess::Kind::kCompareValue,
+                             std::string(symbols.name(instruction.a)),
+                             std::to_string(instruction.number)});
+        break;
+      case adventure::conditions::OpCode::kNot:
+      case adventure::conditions::OpCode::kAnd:
+      case adventure::conditions::OpCode::kOr:
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+std::vector<MemoryAccess> collect_memory_accesses(const adventure::parser::ParsedLevelData& data) {
+  std::vector<MemoryAccess> accesses;
+  collect_mutations(data.on_enter_memory, &accesses);
+  for (const auto& effect : data.option_effects) {
+    collect_mutations(effect.mutations, &accesses);
+  }
+  for (const auto& condition : data.option_conditions) {
+    for (const std::string& flag : condition.required_flags) {
+      accesses.push_back({MemoryAccess::Kind::kReadFlag, flag, ""});
+    }
+    for (const std::string& flag : condition.forbidden_flags) {
+      accesses.push_back({MemoryAccess::Kind::kReadFlag, flag, ""});
+    }
+    for (const auto& [key, value] : condition.required_values) {
+      accesses.push_back({MemoryAccess::Kind::kCompareValue, key, canonical_value(value)});
+    }
+    for (const std::string& key : condition.required_missing_values) {
+      accesses.push_back({MemoryAccess::Kind::kReadValue, key, ""});
+    }
+    for (const auto& bound : condition.number_bounds) {
+      accesses.push_back({MemoryAccess::Kind::kReadValue, bound.key, ""});
+    }
+    collect_expression(condition.expression, &accesses);
+  }
+  return accesses;
+}
+
+std::uint32_t MemoryLint::intern(std::unordered_map<std::string, std::uint32_t>* ids,
+                                 std::vector<KeyUsage>* usages, const std::string& key) {
+  const auto [it, inserted] = ids->emplace(key, static_cast<std::uint32_t>(usages->size()));
+  if (inserted) {
+    usages->push_back({key, kNone, kNone, false});
+  }
+  return it->second;
+}
+
+std::uint32_t MemoryLint::intern_value(const std::string& value) {
+  const auto [it, inserted] = value_ids_.emplace(value, static_cast<std::uint32_t>(values_.size()));
+  if (inserted) {
+    values_.push_back(value);
+  }
+  return it->second;
+}
+
+void MemoryLint::add_level(std::uint32_t level, const std::vector<MemoryAccess>& accesses) {
+  const auto mark = [level](std::uint32_t* first) {
+    if (*first == kNone) {
+      *first = level;
+    }
+  };
+
+  for (const MemoryAccess& access : accesses) {
+    switch (access.kind) {
+      case MemoryAccess::Kind::kSetFlag:
+        mark(&flags_[intern(&flag_ids_, &flags_, access.key)].first_write);
+        break;
+      case MemoryAccess::Kind::kReadFlag:
+        mark(&flags_[intern(&flag_ids_, &flags_, access.key)].first_read);
+        break;
+      case MemoryAccess::Kind::kSetValue: {
+        const std::uint32_t key = intern(&value_key_ids_, &value_keys_, access.key);
+        mark(&value_keys_[key].first_write);
+        assigned_.insert(pair_id(key, intern_value(access.value)));
+        break;
+      }
+      case MemoryAccess::Kind::kReadValue:
+        mark(&value_keys_[intern(&value_key_ids_, &value_keys_, access.key)].first_read);
+        break;
+      case MemoryAccess::Kind::kAddNumber: {
+        KeyUsage& usage = value_keys_[intern(&value_key_ids_, &value_keys_, access.key)];
+        mark(&usage.first_write);
+        usage.counted = true;
+        break;
+      }
+      case MemoryAccess::Kind::kCompareValue: {
+        const std::uint32_t key = intern(&value_key_ids_, &value_keys_, access.key);
+        const std::uint32_t value = intern_value(access.value);
+        mark(&value_keys_[key].first_read);
+        if (compared_.emplace(pair_id(key, value), Comparison{key, value, level}).second) {
+          compare_order_.push_back(pair_id(key, value));
+        }
+        break;
+      }
+    }
+  }
+}
+
+std::vector<MemoryLintFinding> MemoryLint::findings() const {
+  std::vector<MemoryLintFinding> findings;
+  for (const KeyUsage& flag : flags_) {
+    if (flag.first_write == kNone) {
+      findings.push_back({flag.first_read, "Flag `" + flag.name +
+                                               "` is checked by a condition but no add_flag "
+                                               "ever sets it."});
+    } else if (flag.first_read == kNone) {
+      findings.push_back(
+          {flag.first_write, "Flag `" + flag.name + "` is set but no condition reads it."});
+    }
+  }
+
+  for (const KeyUsage& key : value_keys_) {
+    if (key.first_write == kNone) {
+      findings.push_back({key.first_read, "Value `" + key.name +
+                                              "` is checked by a condition but no set_value "
+                                              "or add_value ever assigns it."});
+    } else if (key.first_read == kNone) {
+      findings.push_back(
+          {key.first_write, "Value `" + key.name + "` is assigned but no condition reads it."});
+    }
+  }
+
+  for (const std::uint64_t id : compare_order_) {
+    const Comparison& comparison = compared_.at(id);
+    const KeyUsage& key = value_keys_[comparison.key];
+    if (key.first_write != kNone && !key.counted && assigned_.find(id) == assigned_.end()) {
+      findings.push_back({comparison.level, "Value `" + key.name + "` is compared against `" +
+                                                values_[comparison.value] +
+                                                "`, which no set_value ever assigns."});
+    }
+  }
+  return findings;
+}
+
+}  // namespace adventure::validation
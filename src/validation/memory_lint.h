@@ -0,0 +1,82 @@
+#ifndef CLI_ADVENTURE_VALIDATION_MEMORY_LINT_H_
+#define CLI_ADVENTURE_VALIDATION_MEMORY_LINT_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "parser/parsed_level.h"
+
+namespace adventure::validation {
+
+// One place a level touches game memory. Clearing a flag or erasing a value is neither a read
+// nor a write here: it cannot make a condition true.
+struct MemoryAccess {
+  enum class Kind {
+    kSetFlag,       // add_flag
+    kReadFlag,      // requires_flag / forbids_flag, or a flag in a `when` expression
+    kSetValue,      // set_value, `value` is the assigned string or number
+    kReadValue,     // requires_missing_value / has(key), or a number bound such as key >= 3
+    kCompareValue,  // requires_value / key == value, `value` is the compared string or number
+    kAddNumber,     // add_value / sub_value; any number may follow
+  };
+
+  Kind kind;
+  std::string key;
+  std::string value;
+};
+
+std::vector<MemoryAccess> collect_memory_accesses(const adventure::parser::ParsedLevelData& data);
+
+struct MemoryLintFinding {
+  std::uint32_t level;
+  std::string message;
+};
+
+// Whole-game dataflow check over flags and value keys. Keys and values are interned once, so the
+// pass is linear in the number of accesses.
+class MemoryLint {
+ public:
+  void add_level(std::uint32_t level, const std::vector<MemoryAccess>& accesses);
+  std::vector<MemoryLintFinding> findings() const;
+
+ private:
+  static constexpr std::uint32_t kNone = UINT32_MAX;
+
+  struct KeyUsage {
+    std::string name;
+    std::uint32_t first_write = kNone;
+    std::uint32_t first_read = kNone;
+    bool counted = false;  // changed by add_value/sub_value, so any number may be compared
+  };
+
+  struct Comparison {
+    std::uint32_t key;
+    std::uint32_t value;
+    std::uint32_t level;
+  };
+
+  static std::uint64_t pair_id(std::uint32_t key, std::uint32_t value) {
+    return (static_cast<std::uint64_t>(key) << 32) | value;
+  }
+
+  std::uint32_t intern(std::unordered_map<std::string, std::uint32_t>* ids,
+                       std::vector<KeyUsage>* usages, const std::string& key);
+  std::uint32_t intern_value(const std::string& value);
+
+  std::unordered_map<std::string, std::uint32_t> flag_ids_;
+  std::vector<KeyUsage> flags_;
+  std::unordered_map<std::string, std::uint32_t> value_key_ids_;
+  std::vector<KeyUsage> value_keys_;
+  std::unordered_map<std::string, std::uint32_t> value_ids_;
+  std::vector<std::string> values_;
+  std::unordered_set<std::uint64_t> assigned_;             // (key, value) pairs
+  std::unordered_map<std::uint64_t, Comparison> compared_;  // (key, value) -> first use
+  std::vector<std::uint64_t> compare_order_;
+};
+
+}  // namespace adventure::validation
+
+#endif  // CLI_ADVENTURE_VALIDATION_MEMORY_LINT_H_
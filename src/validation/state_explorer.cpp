@@ -0,0 +1,501 @@
+#include "validation/state_explorer.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "conditions/condition_program.h"
+#include "parser/parsed_level.h"
+#include "parser/tag_parser.h"
+#include "validation/level_graph.h"
+
+namespace adventure::validation {
+namespace {
+
+constexpr std::uint32_t kMissingLevel = UINT32_MAX;
+constexpr std::uint64_t kNumberSlot = 1;
+constexpr std::uint64_t kFirstTextSlot = 2;
+
+class Interner {
+ public:
+  std::uint32_t intern(const std::string& text) {
+    const auto it = ids_.find(text);
+    if (it != ids_.end()) {
+      return it->second;
+    }
+    const std::uint32_t id = static_cast<std::uint32_t>(ids_.size());
+    ids_.emplace(text, id);
+    return id;
+  }
+
+  std::size_t size() const { return ids_.size(); }
+
+ private:
+  std::unordered_map<std::string, std::uint32_t> ids_;
+};
+
+struct CompiledMutation {
+  adventure::parser::MemoryMutation::Kind kind;
+  std::uint32_t key = 0;
+  std::uint32_t value = 0;
+  std::int64_t number = 0;
+};
+
+struct CompiledEdge {
+  std::string choice;
+  std::uint32_t target = kMissingLevel;
+  adventure::conditions::ConditionProgram guard;  // in this explorer's symbol space
+  std::vector<CompiledMutation> effects;
+};
+
+struct CompiledLevel {
+  std::filesystem::path path;
+  LevelKind kind = LevelKind::kPlayable;
+  std::vector<CompiledMutation> on_enter;
+  std::vector<CompiledEdge> edges;
+};
+
+// Memory is a fixed-width row of words: flag bits first, then two words per value key. The first
+// holds kNumberSlot for a number or the interned text id + kFirstTextSlot (0 means the key is
+// unset); the second holds the number's bits.
+struct CompiledGame {
+  std::vector<CompiledLevel> levels;
+  std::uint32_t start = kMissingLevel;
+  std::size_t flag_words = 0;
+  std::size_t width = 0;
+};
+
+struct Symbols {
+  Interner flags;
+  Interner value_keys;
+  Interner values;
+};
+
+std::vector<CompiledMutation> compile_mutations(
+    const std::vector<adventure::parser::MemoryMutation>& mutations, Symbols* symbols) {
+  using Kind = adventure::parser::MemoryMutation::Kind;
+  std::vector<CompiledMutation> compiled;
+  compiled.reserve(mutations.size());
+  for (const auto& mutation : mutations) {
+    CompiledMutation out{mutation.kind, 0, 0, mutation.number};
+    if (mutation.kind == Kind::kAddFlag || mutation.kind == Kind::kClearFlag) {
+      out.key = symbols->flags.intern(mutation.key);
+    } else {
+      out.key = symbols->value_keys.intern(mutation.key);
+      if (mutation.kind == Kind::kSetValue) {
+        out.value = symbols->values.intern(mutation.value);
+      }
+    }
+    compiled.push_back(out);
+  }
+  return compiled;
+}
+
+// The engine's compiled guard for one option or rule, moved from the process-wide memory symbols
+// onto this game's dense flag, value-key and value ids.
+bool compile_guard(const adventure::parser::ParsedLevelData& data, const std::string& id,
+                   Symbols* symbols, adventure::conditions::ConditionProgram* guard) {
+  adventure::conditions::ConditionProgram program;
+  std::string error;
+  if (!adventure::conditions::compile_guard(data.option_conditions, id, &program, &error)) {
+    return false;
+  }
+  const adventure::context::MemorySymbols& names = adventure::context::memory_symbols();
+  *guard = program.remapped([&](adventure::conditions::OpCode op, int operand,
+                                adventure::context::Symbol symbol) {
+    const std::string name(names.name(symbol));
+    if (op == adventure::conditions::OpCode::kFlag) {
+      return symbols->flags.intern(name);
+    }
+    return operand == 0 ? symbols->value_keys.intern(name) : symbols->values.intern(name);
+  });
+  return true;
+}
+
+std::uint32_t resolve_target(const std::filesystem::path& level_path, const std::string& target,
+                             const std::unordered_map<std::string, std::uint32_t>& ids) {
+  const std::filesystem::path target_path(target);
+  const std::filesystem::path resolved = target_path.is_absolute()
+                                             ? target_path.lexically_normal()
+                                             : (level_path.parent_path() / target_path)
+                                                   .lexically_normal();
+  const auto it = ids.find(resolved.string());
+  return it == ids.end() ? kMissingLevel : it->second;
+}
+
+// Returns false when the option's conditions do not compile; the engine then refuses the level.
+bool add_edge(const adventure::parser::ParsedLevelData& data, const std::string& id,
+              std::uint32_t target, CompiledLevel* level, Symbols* symbols) {
+  CompiledEdge edge;
+  if (!compile_guard(data, id, symbols, &edge.guard)) {
+    return false;
+  }
+  if (target == kMissingLevel) {
+    return true;  // the engine would stop with a structure error; not a way forward
+  }
+  edge.choice = id;
+  edge.target = target;
+  for (const auto& effect : data.option_effects) {
+    if (effect.option_id == id) {
+      const std::vector<CompiledMutation> mutations = compile_mutations(effect.mutations, symbols);
+      edge.effects.insert(edge.effects.end(), mutations.begin(), mutations.end());
+    }
+  }
+  level->edges.push_back(std::move(edge));
+  return true;
+}
+
+CompiledGame compile_game(const std::filesystem::path& game_root) {
+  std::vector<std::filesystem::path> paths;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(game_root)) {
+    if (entry.is_regular_file() && entry.path().extension() == ".level") {
+      paths.push_back(entry.path().lexically_normal());
+    }
+  }
+  std::sort(paths.begin(), paths.end());
+
+  std::unordered_map<std::string, std::uint32_t> ids;
+  ids.reserve(paths.size());
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    ids.emplace(paths[i].string(), static_cast<std::uint32_t>(i));
+  }
+
+  CompiledGame game;
+  Symbols symbols;
+  adventure::parser::TagParser parser;
+  game.levels.resize(paths.size());
+  for (std::size_t i = 0; i < paths.size(); ++i) {
+    CompiledLevel& level = game.levels[i];
+    level.path = paths[i];
+
+    adventure::parser::ParsedLevelData data;
+    try {
+      data = parser.parse_file(paths[i]);
+    } catch (const std::exception&) {
+      level.kind = LevelKind::kGameOver;
+      continue;
+    }
+
+    const adventure::parser::InputMode mode = adventure::parser::input_mode_of(data);
+    if (mode == adventure::parser::InputMode::kEndGame) {
+      const auto result_it = data.directives.find("result");
+      level.kind = (result_it != data.directives.end() && result_it->second == "victory")
+                       ? LevelKind::kVictory
+                       : LevelKind::kGameOver;
+      continue;
+    }
+
+    level.on_enter = compile_mutations(data.on_enter_memory, &symbols);
+    bool guards_compile = true;
+    if (mode == adventure::parser::InputMode::kInput) {
+      for (std::size_t r = 0; r < data.input_rules.size() && guards_compile; ++r) {
+        const auto& rule = data.input_rules[r];
+        const std::string id = rule.id.empty() ? "rule_" + std::to_string(r + 1) : rule.id;
+        guards_compile =
+            add_edge(data, id, resolve_target(paths[i], rule.target, ids), &level, &symbols);
+      }
+    } else {
+      for (std::size_t o = 0; o < data.options.size() && guards_compile; ++o) {
+        const auto& option = data.options[o];
+        const std::string id = option.id.empty() ? "option_" + std::to_string(o + 1) : option.id;
+        guards_compile =
+            add_edge(data, id, resolve_target(paths[i], option.target, ids), &level, &symbols);
+      }
+    }
+    if (!guards_compile) {
+      level.kind = LevelKind::kGameOver;
+      level.edges.clear();
+    }
+  }
+
+  const auto start_it = ids.find((game_root / "start.level").lexically_normal().string());
+  if (start_it != ids.end()) {
+    game.start = start_it->second;
+  }
+  game.flag_words = (symbols.flags.size() + 63) / 64;
+  game.width = std::max<std::size_t>(game.flag_words + 2 * symbols.value_keys.size(), 1);
+  return game;
+}
+
+bool has_flag(const std::uint64_t* memory, std::uint32_t flag) {
+  return ((memory[flag / 64] >> (flag % 64)) & 1u) != 0;
+}
+
+void apply_mutations(const CompiledGame& game, const std::vector<CompiledMutation>& mutations,
+                     std::uint64_t* memory) {
+  using Kind = adventure::parser::MemoryMutation::Kind;
+  for (const auto& mutation : mutations) {
+    const auto slot = [&] { return memory + game.flag_words + 2 * std::size_t{mutation.key}; };
+    switch (mutation.kind) {
+      case Kind::kAddFlag:
+        memory[mutation.key / 64] |= std::uint64_t{1} << (mutation.key % 64);
+        break;
+      case Kind::kClearFlag:
+        memory[mutation.key / 64] &= ~(std::uint64_t{1} << (mutation.key % 64));
+        break;
+      case Kind::kSetValue:
+        slot()[0] = mutation.value + kFirstTextSlot;
+        slot()[1] = 0;
+        break;
+      case Kind::kEraseValue:
+        slot()[0] = 0;
+        slot()[1] = 0;
+        break;
+      case Kind::kSetNumber:
+        slot()[0] = kNumberSlot;
+        slot()[1] = static_cast<std::uint64_t>(mutation.number);
+        break;
+      case Kind::kAddNumber: {
+        const std::int64_t current =
+            slot()[0] == kNumberSlot ? static_cast<std::int64_t>(slot()[1]) : 0;
+        slot()[0] = kNumberSlot;
+        slot()[1] = static_cast<std::uint64_t>(
+            adventure::context::add_saturating(current, mutation.number));
+        break;
+      }
+    }
+  }
+}
+
+// Memory row as seen by a compiled guard.
+struct RowMemory {
+  const CompiledGame& game;
+  const std::uint64_t* memory;
+
+  const std::uint64_t* slot(adventure::context::Symbol key) const {
+    return memory + game.flag_words + 2 * std::size_t{key};
+  }
+  bool has_flag(adventure::context::Symbol flag) const {
+    return adventure::validation::has_flag(memory, flag);
+  }
+  bool has_value(adventure::context::Symbol key) const { return slot(key)[0] != 0; }
+  adventure::context::Symbol value_of(adventure::context::Symbol key) const {
+    const std::uint64_t tag = slot(key)[0];
+    return tag < kFirstTextSlot ? adventure::context::kNoSymbol
+                                : static_cast<adventure::context::Symbol>(tag - kFirstTextSlot);
+  }
+  bool number_of(adventure::context::Symbol key, std::int64_t* value) const {
+    *value = static_cast<std::int64_t>(slot(key)[1]);
+    return slot(key)[0] < kFirstTextSlot;
+  }
+};
+
+std::uint64_t mix(std::uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xbf58476d1ce4e5b9ull;
+  value ^= value >> 27;
+  value *= 0x94d049bb133111ebull;
+  value ^= value >> 31;
+  return value;
+}
+
+std::uint64_t hash_state(std::uint32_t level, const std::uint64_t* memory, std::size_t width) {
+  std::uint64_t hash = mix(0x9e3779b97f4a7c15ull ^ level);
+  for (std::size_t i = 0; i < width; ++i) {
+    hash = mix(hash ^ (memory[i] + 0x9e3779b97f4a7c15ull));
+  }
+  return hash == 0 ? 1 : hash;  // 0 marks an empty slot
+}
+
+// Open-addressing set of state hashes; insertion is a single CAS per probed slot.
+class ConcurrentHashSet {
+ public:
+  explicit ConcurrentHashSet(std::size_t max_entries) {
+    std::size_t capacity = 1024;
+    while (capacity < max_entries * 2) {
+      capacity *= 2;
+    }
+    slots_ = std::make_unique<std::atomic<std::uint64_t>[]>(capacity);
+    for (std::size_t i = 0; i < capacity; ++i) {
+      slots_[i].store(0, std::memory_order_relaxed);
+    }
+    mask_ = capacity - 1;
+  }
+
+  bool insert(std::uint64_t hash) {
+    for (std::size_t slot = hash & mask_, probes = 0; probes <= mask_;
+         slot = (slot + 1) & mask_, ++probes) {
+      std::uint64_t current = slots_[slot].load(std::memory_order_relaxed);
+      if (current == hash) {
+        return false;
+      }
+      if (current == 0) {
+        if (slots_[slot].compare_exchange_strong(current, hash, std::memory_order_relaxed)) {
+          return true;
+        }
+        if (current == hash) {
+          return false;
+        }
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::unique_ptr<std::atomic<std::uint64_t>[]> slots_;
+  std::size_t mask_ = 0;
+};
+
+struct Layer {
+  std::vector<std::uint32_t> levels;
+  std::vector<std::uint32_t> parents;  // index into the previous layer
+  std::vector<std::uint32_t> choices;  // edge index within the parent's level
+  std::vector<std::uint64_t> memory;   // `width` words per state
+  std::size_t first_victory = SIZE_MAX;
+
+  std::size_t size() const { return levels.size(); }
+
+  void append(const Layer& other) {
+    if (first_victory == SIZE_MAX && other.first_victory != SIZE_MAX) {
+      first_victory = size() + other.first_victory;
+    }
+    levels.insert(levels.end(), other.levels.begin(), other.levels.end());
+    parents.insert(parents.end(), other.parents.begin(), other.parents.end());
+    choices.insert(choices.end(), other.choices.begin(), other.choices.end());
+    memory.insert(memory.end(), other.memory.begin(), other.memory.end());
+  }
+};
+
+struct SearchShared {
+  const CompiledGame& game;
+  ConcurrentHashSet& visited;
+  std::atomic<std::size_t>& discovered;
+  std::atomic<bool>& truncated;
+  std::size_t max_states;
+};
+
+void expand_range(const SearchShared& shared, const Layer& frontier, std::size_t begin,
+                  std::size_t end, Layer* next) {
+  const CompiledGame& game = shared.game;
+  std::vector<std::uint64_t> entered(game.width);
+  std::vector<std::uint64_t> successor(game.width);
+
+  for (std::size_t state = begin; state < end; ++state) {
+    const CompiledLevel& level = game.levels[frontier.levels[state]];
+    if (level.kind != LevelKind::kPlayable) {
+      continue;
+    }
+    std::copy_n(frontier.memory.begin() + static_cast<std::ptrdiff_t>(state * game.width),
+                game.width, entered.begin());
+    apply_mutations(game, level.on_enter, entered.data());
+
+    for (std::size_t e = 0; e < level.edges.size(); ++e) {
+      const CompiledEdge& edge = level.edges[e];
+      if (!edge.guard.run(RowMemory{game, entered.data()})) {
+        continue;
+      }
+      successor = entered;
+      apply_mutations(game, edge.effects, successor.data());
+      if (!shared.visited.insert(hash_state(edge.target, successor.data(), game.width))) {
+        continue;
+      }
+      if (shared.discovered.fetch_add(1, std::memory_order_relaxed) >= shared.max_states) {
+        shared.truncated.store(true, std::memory_order_relaxed);
+        return;
+      }
+      if (next->first_victory == SIZE_MAX &&
+          game.levels[edge.target].kind == LevelKind::kVictory) {
+        next->first_victory = next->size();
+      }
+      next->levels.push_back(edge.target);
+      next->parents.push_back(static_cast<std::uint32_t>(state));
+      next->choices.push_back(static_cast<std::uint32_t>(e));
+      next->memory.insert(next->memory.end(), successor.begin(), successor.end());
+    }
+  }
+}
+
+std::vector<PathStep> reconstruct_path(const CompiledGame& game, const std::vector<Layer>& layers,
+                                       std::size_t state) {
+  std::vector<PathStep> path;
+  path.push_back({game.levels[layers.back().levels[state]].path, ""});
+  for (std::size_t depth = layers.size() - 1; depth > 0; --depth) {
+    const Layer& layer = layers[depth];
+    const std::uint32_t parent = layer.parents[state];
+    const CompiledLevel& parent_level = game.levels[layers[depth - 1].levels[parent]];
+    path.push_back({parent_level.path, parent_level.edges[layer.choices[state]].choice});
+    state = parent;
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+}  // namespace
+
+ExplorationReport explore_game(const std::filesystem::path& game_root,
+                               const ExplorerOptions& options) {
+  ExplorationReport report;
+  const CompiledGame game = compile_game(game_root);
+  if (game.start == kMissingLevel) {
+    return report;
+  }
+  const auto started = std::chrono::steady_clock::now();
+
+  const unsigned thread_count =
+      options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+  ConcurrentHashSet visited(options.max_states);
+  std::atomic<std::size_t> discovered{1};
+  std::atomic<bool> truncated{false};
+  const SearchShared shared{game, visited, discovered, truncated, options.max_states};
+
+  std::vector<Layer> layers(1);
+  layers[0].levels.push_back(game.start);
+  layers[0].parents.push_back(0);
+  layers[0].choices.push_back(0);
+  layers[0].memory.assign(game.width, 0);
+  visited.insert(hash_state(game.start, layers[0].memory.data(), game.width));
+  if (game.levels[game.start].kind == LevelKind::kVictory) {
+    layers[0].first_victory = 0;
+  }
+
+  constexpr std::size_t kMinStatesPerThread = 256;
+  while (layers.back().first_victory == SIZE_MAX && layers.back().size() > 0 &&
+         !truncated.load()) {
+    const Layer& frontier = layers.back();
+    const std::size_t workers = std::min<std::size_t>(
+        thread_count, std::max<std::size_t>(1, frontier.size() / kMinStatesPerThread));
+
+    std::vector<Layer> partial(workers);
+    if (workers == 1) {
+      expand_range(shared, frontier, 0, frontier.size(), &partial[0]);
+    } else {
+      std::vector<std::thread> pool;
+      pool.reserve(workers);
+      const std::size_t chunk = (frontier.size() + workers - 1) / workers;
+      for (std::size_t w = 0; w < workers; ++w) {
+        const std::size_t begin = std::min(frontier.size(), w * chunk);
+        const std::size_t end = std::min(frontier.size(), begin + chunk);
+        pool.emplace_back(expand_range, std::cref(shared), std::cref(frontier), begin, end,
+                          &partial[w]);
+      }
+      for (std::thread& worker : pool) {
+        worker.join();
+      }
+    }
+
+    Layer next;
+    for (const Layer& part : partial) {
+      next.append(part);
+    }
+    layers.push_back(std::move(next));
+  }
+
+  if (layers.back().first_victory != SIZE_MAX) {
+    report.victory_reachable = true;
+    report.winning_path = reconstruct_path(game, layers, layers.back().first_victory);
+  }
+  report.truncated = truncated.load();
+  report.states_explored = std::min(discovered.load(), options.max_states);
+  report.seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+  report.states_per_second =
+      report.seconds > 0.0 ? static_cast<double>(report.states_explored) / report.seconds : 0.0;
+  return report;
+}
+
+}  // namespace adventure::validation
@@ -0,0 +1,40 @@
+#ifndef CLI_ADVENTURE_VALIDATION_STATE_EXPLORER_H_
+#define CLI_ADVENTURE_VALIDATION_STATE_EXPLORER_H_
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace adventure::validation {
+
+struct ExplorerOptions {
+  std::size_t max_states = 1000000;
+  unsigned threads = 0;  // 0 = std::thread::hardware_concurrency()
+};
+
+struct PathStep {
+  std::filesystem::path level;
+  std::string choice;  // option/rule id taken to leave `level`; empty on the final step
+};
+
+struct ExplorationReport {
+  bool victory_reachable = false;
+  bool truncated = false;  // max_states was hit before the search finished
+  std::vector<PathStep> winning_path;
+  std::size_t states_explored = 0;
+  double seconds = 0.0;  // search time, excluding level loading
+  double states_per_second = 0.0;
+};
+
+// Breadth-first search over (level, memory) states, replaying `[MEMORY]` on-enter mutations,
+// `[OPTION_CONDITIONS]` and `[OPTION_EFFECTS]` exactly as the engine does. Input rules are
+// treated as edges the player can always type. States are deduplicated by a 64-bit hash in a
+// lock-free table, and each BFS layer is expanded by a pool of worker threads, so the first
+// victory found lies on a shortest winning path.
+ExplorationReport explore_game(const std::filesystem::path& game_root,
+                               const ExplorerOptions& options = ExplorerOptions{});
+
+}  // namespace adventure::validation
+
+#endif  // CLI_ADVENTURE_VALIDATION_STATE_EXPLORER_H_
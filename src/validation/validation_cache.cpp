@@ -0,0 +1,123 @@
+#include "validation/validation_cache.h"
+
+#include <fstream>
+#include <sstream>
+#include <system_error>
+
+namespace adventure::validation {
+namespace {
+
+constexpr const char* kCacheHeader = "cli_adventure_validation_cache 4";
+
+// Paths are stored relative to the game root so the cache survives moving the game folder.
+std::string to_relative(const std::filesystem::path& game_root, const std::string& path) {
+  return std::filesystem::path(path)
+      .lexically_relative(game_root.lexically_normal())
+      .generic_string();
+}
+
+std::string from_relative(const std::filesystem::path& game_root, const std::string& path) {
+  return (game_root / path).lexically_normal().string();
+}
+
+std::vector<std::string> split_tabs(const std::string& line) {
+  std::vector<std::string> fields;
+  std::size_t start = 0;
+  while (true) {
+    const std::size_t tab = line.find('\t', start);
+    fields.push_back(line.substr(start, tab - start));
+    if (tab == std::string::npos) {
+      return fields;
+    }
+    start = tab + 1;
+  }
+}
+
+}  // namespace
+
+std::uint64_t hash_level_content(std::string_view content) {
+  std::uint64_t hash = 0xcbf29ce484222325ull;  // FNV-1a
+  for (const char ch : content) {
+    hash ^= static_cast<unsigned char>(ch);
+    hash *= 0x100000001b3ull;
+  }
+  return hash;
+}
+
+ValidationCache load_validation_cache(const std::filesystem::path& game_root) {
+  ValidationCache cache;
+  std::ifstream in(game_root / kValidationCacheFileName);
+  std::string line;
+  if (!in.is_open() || !std::getline(in, line) || line != kCacheHeader) {
+    return cache;
+  }
+
+  CachedLevel* current = nullptr;
+  while (std::getline(in, line)) {
+    const std::vector<std::string> fields = split_tabs(line);
+    try {
+      if (fields[0] == "F" && fields.size() == 6) {
+        CachedLevel level;
+        level.size = std::stoull(fields[2]);
+        level.mtime = std::stoll(fields[3]);
+        level.content_hash = std::stoull(fields[4], nullptr, 16);
+        level.kind = static_cast<LevelKind>(std::stoi(fields[5]));
+        current = &(cache[from_relative(game_root, fields[1])] = std::move(level));
+      } else if (fields[0] == "T" && fields.size() == 3 && current != nullptr) {
+        current->targets.push_back({from_relative(game_root, fields[2]), fields[1] == "1"});
+      } else if (fields[0] == "M" && fields.size() == 4 && current != nullptr) {
+        current->memory.push_back(
+            {static_cast<MemoryAccess::Kind>(std::stoi(fields[1])), fields[2], fields[3]});
+      } else if (fields[0] == "I" && fields.size() >= 2 && current != nullptr) {
+        current->issues.push_back(line.substr(2));
+      } else {
+        return {};
+      }
+    } catch (const std::exception&) {
+      return {};  // a damaged cache only costs a full re-validation
+    }
+  }
+  return cache;
+}
+
+void save_validation_cache(const std::filesystem::path& game_root, const ValidationCache& cache) {
+  const std::filesystem::path cache_path = game_root / kValidationCacheFileName;
+  const std::filesystem::path temp_path =
+      game_root / (std::string(kValidationCacheFileName) + ".tmp");
+
+  {
+    std::ofstream out(temp_path, std::ios::trunc);
+    if (!out.is_open()) {
+      return;
+    }
+    out << kCacheHeader << "\n";
+    for (const auto& [path, level] : cache) {
+      std::ostringstream hash;
+      hash << std::hex << level.content_hash;
+      out << "F\t" << to_relative(game_root, path) << "\t" << level.size << "\t" << level.mtime
+          << "\t" << hash.str() << "\t" << static_cast<int>(level.kind) << "\n";
+      for (const CachedTarget& target : level.targets) {
+        out << "T\t" << (target.exists ? "1" : "0") << "\t" << to_relative(game_root, target.path)
+            << "\n";
+      }
+      for (const MemoryAccess& access : level.memory) {
+        out << "M\t" << static_cast<int>(access.kind) << "\t" << access.key << "\t" << access.value
+            << "\n";
+      }
+      for (const std::string& issue : level.issues) {
+        out << "I\t" << issue << "\n";
+      }
+    }
+    if (!out) {
+      return;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temp_path, cache_path, error);
+  if (error) {
+    std::filesystem::remove(temp_path, error);
+  }
+}
+
+}  // namespace adventure::validation
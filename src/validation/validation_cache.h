@@ -0,0 +1,45 @@
+#ifndef CLI_ADVENTURE_VALIDATION_VALIDATION_CACHE_H_
+#define CLI_ADVENTURE_VALIDATION_VALIDATION_CACHE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "validation/level_graph.h"
+#include "validation/memory_lint.h"
+
+namespace adventure::validation {
+
+inline constexpr const char* kValidationCacheFileName = ".validation_cache";
+
+struct CachedTarget {
+  std::string path;  // resolved target path
+  bool exists = false;
+};
+
+// Per-level validation result plus what it depended on: the file content (size, mtime and a
+// content hash) and the existence of every target it references. `memory` feeds the whole-game
+// memory lint, which is re-run on every validation.
+struct CachedLevel {
+  std::uintmax_t size = 0;
+  std::int64_t mtime = 0;
+  std::uint64_t content_hash = 0;
+  LevelKind kind = LevelKind::kPlayable;
+  std::vector<CachedTarget> targets;
+  std::vector<std::string> issues;
+  std::vector<MemoryAccess> memory;
+};
+
+// Keyed by level path as produced by walking `game_root`.
+using ValidationCache = std::unordered_map<std::string, CachedLevel>;
+
+std::uint64_t hash_level_content(std::string_view content);
+ValidationCache load_validation_cache(const std::filesystem::path& game_root);
+void save_validation_cache(const std::filesystem::path& game_root, const ValidationCache& cache);
+
+}  // namespace adventure::validation
+
+#endif  // CLI_ADVENTURE_VALIDATION_VALIDATION_CACHE_H_
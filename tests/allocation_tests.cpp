@@ -0,0 +1,278 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "conditions/condition_program.h"
+#include "context/game_context.h"
+#include "engine/engine.h"
+#include "levels/choice_level.h"
+#include "levels/terminal_level_factory.h"
+#include "parser/tag_parser.h"
+#include "support/allocation_counter.h"
+#include "ui/renderer.h"
+#include "ui/theme.h"
+
+namespace {
+
+using adventure::test_support::AllocationScope;
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+class DiscardBuffer : public std::streambuf {
+ protected:
+  int overflow(int ch) override { return ch; }
+  std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+adventure::parser::ParsedLevelData parse_text(const std::string& text) {
+  std::istringstream input(text);
+  return adventure::parser::TagParser().parse(input);
+}
+
+void test_cached_render_scene_does_not_allocate() {
+  DiscardBuffer buffer;
+  std::ostream discard(&buffer);
+  const adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  adventure::parser::TextLines content;
+  for (int i = 0; i < 12; ++i) {
+    content.push_back("A long corridor lit by flickering torches.");
+  }
+  const std::string key = "/games/bench/hall_of_many_doors.level";
+
+  renderer.render_cached_scene(discard, key, "Hall", content, "/games/bench", "");
+  AllocationScope scope;
+  for (int i = 0; i < 100; ++i) {
+    renderer.render_cached_scene(discard, key, "Hall", content, "/games/bench", "");
+  }
+  const std::size_t allocations = scope.counts().allocations;
+  expect(allocations == 0, "A cached scene must be re-emitted without allocating.");
+}
+
+std::string gated_level(std::size_t conditions_per_option) {
+  std::string text = "[OPTIONS]\n";
+  for (int option = 0; option < 4; ++option) {
+    text += "door_" + std::to_string(option) + " | Open door -> ./room.level\n";
+  }
+  text += "\n[OPTION_CONDITIONS]\n";
+  for (int option = 0; option < 4; ++option) {
+    for (std::size_t i = 0; i < conditions_per_option; ++i) {
+      const std::string suffix = std::to_string(option) + "_" + std::to_string(i);
+      text += "option=door_" + std::to_string(option) + " requires_flag=key_" + suffix +
+              " forbids_flag=jammed_door_with_a_long_flag_name_" + suffix +
+              " requires_value=zone_" + suffix + ":hall\n";
+    }
+  }
+  return text;
+}
+
+std::size_t choice_execute_allocations(adventure::levels::ChoiceLevel* level,
+                                       const adventure::context::GameContext& base_context) {
+  DiscardBuffer buffer;
+  std::ostream discard(&buffer);
+  adventure::context::GameContext context = base_context;
+  std::istringstream in("1\n");
+  AllocationScope scope;
+  level->execute(in, discard, context);
+  return scope.counts().allocations;
+}
+
+void test_choice_condition_evaluation_does_not_allocate() {
+  const adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  adventure::levels::ChoiceLevel small(parse_text(gated_level(1)), renderer);
+  adventure::levels::ChoiceLevel large(parse_text(gated_level(40)), renderer);
+
+  adventure::context::GameContext context;
+  for (int option = 0; option < 4; ++option) {
+    for (int i = 0; i < 40; ++i) {
+      const std::string suffix = std::to_string(option) + "_" + std::to_string(i);
+      context.set_memory_flag("key_" + suffix);
+      context.set_memory_value("zone_" + suffix, "hall");
+    }
+  }
+
+  // Same visible options either way; only the number of evaluated conditions differs. The first
+  // call warms one-time statics.
+  choice_execute_allocations(&small, context);
+  const std::size_t with_few = choice_execute_allocations(&small, context);
+  const std::size_t with_many = choice_execute_allocations(&large, context);
+  expect(with_few == with_many,
+         "Evaluating more conditions must not add allocations (" + std::to_string(with_few) +
+             " vs " + std::to_string(with_many) + ").");
+}
+
+void test_condition_expression_evaluation_does_not_allocate() {
+  adventure::conditions::ConditionProgram program;
+  std::string error;
+  expect(adventure::conditions::compile_expression(
+             "(has_key or has_lockpick) and not alarm_raised and zone == north_hall_of_the_keep "
+             "and has(torch)",
+             &program, &error),
+         "Expression should compile: " + error);
+  adventure::context::GameContext context;
+  context.set_memory_flag("has_lockpick");
+  context.set_memory_value("zone", "north_hall_of_the_keep");
+  context.set_memory_value("torch", "lit");
+
+  bool passed = true;
+  AllocationScope scope;
+  for (int i = 0; i < 100; ++i) {
+    passed = passed && program.evaluate(context);
+  }
+  const std::size_t allocations = scope.counts().allocations;
+  expect(passed, "Expression should pass for this memory.");
+  expect(allocations == 0, "Evaluating a compiled condition must not allocate.");
+}
+
+void test_cached_engine_transition_allocation_bound() {
+  const std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "cli_adventure_allocation_tests";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root);
+  write_text_file(root / "start.level", R"([HEADER]
+title: Loop Room
+
+[CONTENT]
+You can go around in circles for as long as you like.
+
+[OPTIONS]
+loop | Go around -> ./start.level
+win | Leave -> ./win.level
+)");
+  write_text_file(root / "win.level", "[DIRECTIVES]\ninput_mode: endgame\nresult: victory\n");
+
+  DiscardBuffer buffer;
+  std::ostream discard(&buffer);
+  adventure::engine::Engine engine{adventure::ui::Renderer(adventure::ui::Theme{})};
+  const auto run_with_loops = [&](int loops) {
+    std::string script;
+    for (int i = 0; i < loops; ++i) {
+      script += "1\n";
+    }
+    script += "2\n\n";
+    adventure::context::GameContext context;
+    context.set_current_level_path((root / "start.level").string());
+    std::istringstream in(script);
+    AllocationScope scope;
+    engine.run(in, discard, context);
+    const std::size_t allocations = scope.counts().allocations;
+    expect(context.is_victory(), "Loop game should end in victory.");
+    return allocations;
+  };
+
+  run_with_loops(1);  // warm the level and scene caches
+  const std::size_t short_run = run_with_loops(10);
+  const std::size_t long_run = run_with_loops(110);
+  const double per_transition = static_cast<double>(long_run - short_run) / 100.0;
+  std::cout << "Allocations per cached engine transition: " << per_transition << "\n";
+  // Remaining churn: the menu's label/index vectors and the copied next-level path. Parsing,
+  // level construction, path resolution and scene rendering must stay out of this loop.
+  expect(per_transition <= 4.0,
+         "Cached engine transitions allocate too much: " + std::to_string(per_transition));
+}
+
+std::string described_level(std::size_t content_lines, const std::string& input_mode) {
+  std::string text = "[HEADER]\ntitle: Archive\nascii_art: ./art/shelves_of_the_long_archive.txt\n"
+                     "\n[CONTENT]\n";
+  for (std::size_t i = 0; i < content_lines; ++i) {
+    text += "Shelf " + std::to_string(i) + " holds scrolls nobody has read in a century.\n";
+  }
+  text += "\n[OPTIONS]\nleave | Leave the archive -> ./hall.level\n\n[INPUT_RULES]\n"
+          "answer | the answer to the librarian's riddle -> ./hall.level\n\n[DIRECTIVES]\n"
+          "input_mode: " + input_mode + "\ninput_prompt: What do you tell the librarian?\n"
+          "result: victory\n";
+  return text;
+}
+
+std::size_t create_bytes(const adventure::levels::TerminalLevelFactory& factory,
+                         adventure::parser::ParsedLevelData data) {
+  AllocationScope scope;
+  const std::unique_ptr<adventure::levels::ILevel> level = factory.create(std::move(data));
+  return scope.counts().bytes;
+}
+
+void test_level_construction_moves_parsed_data() {
+  const adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  const adventure::levels::TerminalLevelFactory factory(renderer);
+
+  // The level adopts the parsed strings and vectors, so what it allocates (its own object and
+  // id index) does not depend on how much content the file had.
+  for (const std::string mode : {"choice", "input", "endgame"}) {
+    const std::size_t small = create_bytes(factory, parse_text(described_level(1, mode)));
+    const std::size_t large = create_bytes(factory, parse_text(described_level(200, mode)));
+    expect(small == large, "Creating a " + mode + " level copied parsed data (" +
+                               std::to_string(small) + " vs " + std::to_string(large) +
+                               " bytes).");
+  }
+}
+
+void test_inline_levels_skip_the_level_allocation() {
+  const adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  const adventure::levels::TerminalLevelFactory factory(renderer);
+  for (const std::string mode : {"choice", "input", "endgame"}) {
+    const std::string text = described_level(3, mode);
+    adventure::parser::ParsedLevelData boxed_data = parse_text(text);
+    adventure::parser::ParsedLevelData inline_data = parse_text(text);
+
+    AllocationScope boxed_scope;
+    const std::unique_ptr<adventure::levels::ILevel> boxed = factory.create(std::move(boxed_data));
+    const std::size_t boxed_allocations = boxed_scope.counts().allocations;
+
+    AllocationScope inline_scope;
+    const adventure::levels::TerminalLevel inline_level =
+        factory.create_inline(std::move(inline_data));
+    const std::size_t inline_allocations = inline_scope.counts().allocations;
+
+    expect(inline_allocations + 1 == boxed_allocations,
+           "Inline " + mode + " level should save exactly the level object allocation.");
+  }
+}
+
+void test_parsed_level_text_is_contiguous() {
+  std::string text = "[HEADER]\nid: archive\ntitle: Archive\nauthor: Mira\n\n[CONTENT]\n";
+  for (int i = 0; i < 40; ++i) {
+    text += "Shelf " + std::to_string(i) + " holds scrolls nobody has read in a century.\n";
+  }
+  text += "[DIRECTIVES]\ninput_mode: choice\nresult: none\nmood: calm\n";
+  const adventure::parser::ParsedLevelData data = parse_text(text);
+
+  // Copying allocates exactly what the parsed level owns: the content text buffer and its line
+  // spans, plus one entry vector per field map.
+  AllocationScope scope;
+  const adventure::parser::ParsedLevelData copy = data;
+  const std::size_t allocations = scope.counts().allocations;
+  expect(copy.content_lines.size() == 40, "Copied content should keep every line.");
+  expect(allocations == 4, "40 content lines and 6 fields should own 4 blocks, not " +
+                               std::to_string(allocations) + ".");
+}
+
+}  // namespace
+
+int main() {
+  test_cached_render_scene_does_not_allocate();
+  test_choice_condition_evaluation_does_not_allocate();
+  test_condition_expression_evaluation_does_not_allocate();
+  test_cached_engine_transition_allocation_bound();
+  test_level_construction_moves_parsed_data();
+  test_inline_levels_skip_the_level_allocation();
+  test_parsed_level_text_is_contiguous();
+  return 0;
+}
@@ -0,0 +1,123 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "cli/batch_commands.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+std::filesystem::path make_game(const std::string& name) {
+  const std::filesystem::path root = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root);
+
+  write_text_file(root / "start.level", R"([HEADER]
+title: Gate
+
+[CONTENT]
+A locked gate "stands" here.
+
+[OPTIONS]
+lose | Give up -> ./lose.level
+door | Say the word -> ./door.level
+)");
+  write_text_file(root / "door.level", R"([CONTENT]
+The gate asks for a word.
+
+[DIRECTIVES]
+input_mode: input
+input_match: exact
+
+[INPUT_RULES]
+open | friend -> ./win.level
+)");
+  write_text_file(root / "win.level", R"([DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+  write_text_file(root / "lose.level", R"([DIRECTIVES]
+input_mode: endgame
+result: game_over
+)");
+  return root;
+}
+
+void test_validate_writes_json_and_sets_exit_status() {
+  const std::filesystem::path root = make_game("cli_adventure_batch_validate_tests");
+
+  std::ostringstream clean;
+  expect(adventure::cli::run_validate_command(root, clean) == adventure::cli::kExitOk,
+         "A clean game should validate with exit status 0.");
+  expect(clean.str().find("\"issues\": [],") != std::string::npos,
+         "Clean report should contain an empty issues array.");
+  expect(clean.str().find("\"victory_reachable\": true") != std::string::npos,
+         "Report should include the exploration result.");
+
+  write_text_file(root / "lose.level", "[OPTIONS]\nback | \"Back\" -> ./missing.level\n");
+  std::ostringstream broken;
+  expect(adventure::cli::run_validate_command(root, broken) == adventure::cli::kExitFailed,
+         "Issues should produce exit status 1.");
+  expect(broken.str().find("Missing option target `./missing.level`") != std::string::npos,
+         "Issues should be listed in the report.");
+}
+
+void test_play_runs_script_headless() {
+  const std::filesystem::path root = make_game("cli_adventure_batch_play_tests");
+
+  std::istringstream winning("2\nFriend\n\n");
+  std::ostringstream transcript;
+  expect(adventure::cli::run_play_command(root, winning, transcript) == adventure::cli::kExitOk,
+         "Scripted victory should exit with status 0.");
+  expect(transcript.str().find("\033[") == std::string::npos,
+         "Headless transcript should not contain color escapes.");
+
+  std::istringstream losing("1\n\n");
+  std::ostringstream lost;
+  expect(adventure::cli::run_play_command(root, losing, lost) == adventure::cli::kExitFailed,
+         "Scripted game over should exit with status 1.");
+
+  std::istringstream truncated("2\n");
+  std::ostringstream unfinished;
+  expect(adventure::cli::run_play_command(root, truncated, unfinished) ==
+             adventure::cli::kExitFailed,
+         "A script that ends before the game does should not count as a win.");
+}
+
+void test_bench_reports_each_phase() {
+  const std::filesystem::path root = make_game("cli_adventure_batch_bench_tests");
+  std::ostringstream out;
+  expect(adventure::cli::run_bench_command(root, out) == adventure::cli::kExitOk,
+         "Bench should succeed on a valid game.");
+  for (const char* phase : {"load", "parse", "build", "render", "transition"}) {
+    expect(out.str().find(phase) != std::string::npos,
+           std::string("Bench output should include the ") + phase + " phase.");
+  }
+}
+
+}  // namespace
+
+int main() {
+  test_validate_writes_json_and_sets_exit_status();
+  test_play_runs_script_headless();
+  test_bench_reports_each_phase();
+  return 0;
+}
@@ -1,3 +1,4 @@
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
@@ -102,11 +103,83 @@ void test_memory_condition_shows_locked_option_after_effect() {
   }
 }
 
+void test_condition_expression_gates_option() {
+  adventure::parser::ParsedLevelData data;
+  data.header["title"] = "Vault";
+  data.options = {{"wait", "Wait", "./vault.level"}, {"open", "Open the vault", "./gold.level"}};
+  adventure::parser::OptionCondition condition;
+  condition.option_id = "open";
+  condition.expression = "has_key or has_lockpick";
+  data.option_conditions.push_back(condition);
+
+  adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  adventure::levels::ChoiceLevel level(data, renderer);
+
+  adventure::context::GameContext locked;
+  std::istringstream locked_input("2\n1\n");
+  std::ostringstream locked_output;
+  level.execute(locked_input, locked_output, locked);
+  expect(locked.next_level_request() == "./vault.level",
+         "Without key or lockpick only one option should be offered.");
+
+  adventure::context::GameContext picked;
+  picked.set_memory_flag("has_lockpick");
+  std::istringstream picked_input("2\n");
+  std::ostringstream picked_output;
+  level.execute(picked_input, picked_output, picked);
+  expect(picked.next_level_request() == "./gold.level", "Either item should open the vault.");
+
+  data.option_conditions[0].expression = "has_key or";
+  adventure::levels::ChoiceLevel broken(data, renderer);
+  adventure::context::GameContext context;
+  std::istringstream input("1\n");
+  std::ostringstream output;
+  broken.execute(input, output, context);
+  expect(context.is_game_over() && output.str().find("[Structure Error] Condition for `open`") !=
+                                       std::string::npos,
+         "A condition that does not compile should be a structure error.");
+}
+
+void test_number_bound_and_arithmetic_effect() {
+  adventure::parser::ParsedLevelData data;
+  data.header["title"] = "Shop";
+  data.options = {{"buy", "Buy the rope", "./shop.level"}, {"leave", "Leave", "./village.level"}};
+  adventure::parser::OptionCondition condition;
+  condition.option_id = "buy";
+  condition.number_bounds = {{"gold", 10, false}};
+  data.option_conditions.push_back(condition);
+  adventure::parser::MemoryMutation pay{adventure::parser::MemoryMutation::Kind::kAddNumber,
+                                        "gold", "10"};
+  pay.number = -10;
+  data.option_effects.push_back(adventure::parser::OptionEffect{"buy", {pay}});
+
+  adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  adventure::levels::ChoiceLevel level(data, renderer);
+  adventure::context::GameContext context;
+  context.set_memory_number("gold", 10);
+
+  std::istringstream buy_input("1\n");
+  std::ostringstream buy_output;
+  level.execute(buy_input, buy_output, context);
+  const std::int64_t* gold = context.get_memory_number("gold");
+  expect(context.next_level_request() == "./shop.level" && gold != nullptr && *gold == 0,
+         "Buying should spend the gold.");
+
+  context.clear_next_level_request();
+  std::istringstream broke_input("1\n");
+  std::ostringstream broke_output;
+  level.execute(broke_input, broke_output, context);
+  expect(context.next_level_request() == "./village.level",
+         "Without enough gold only leaving should be offered.");
+}
+
 }  // namespace
 
 int main() {
   test_invalid_then_valid_choice();
   test_choice_level_without_options_is_structure_error();
   test_memory_condition_shows_locked_option_after_effect();
+  test_condition_expression_gates_option();
+  test_number_bound_and_arithmetic_effect();
   return 0;
 }
@@ -0,0 +1,169 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "conditions/condition_program.h"
+#include "context/game_context.h"
+#include "parser/parsed_level.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+bool passes(const std::string& expression, const adventure::context::GameContext& context) {
+  adventure::conditions::ConditionProgram program;
+  std::string error;
+  expect(adventure::conditions::compile_expression(expression, &program, &error),
+         "`" + expression + "` should compile: " + error);
+  return program.evaluate(context);
+}
+
+std::string compile_error(const std::string& expression) {
+  adventure::conditions::ConditionProgram program;
+  std::string error;
+  expect(!adventure::conditions::compile_expression(expression, &program, &error),
+         "`" + expression + "` should not compile.");
+  return error;
+}
+
+void test_boolean_operators_and_precedence() {
+  adventure::context::GameContext context;
+  context.set_memory_flag("has_key");
+
+  expect(passes("has_key", context), "A set flag should pass.");
+  expect(!passes("has_lockpick", context), "An unset flag should fail.");
+  expect(passes("has_lockpick or has_key", context), "`or` needs one side.");
+  expect(!passes("has_lockpick and has_key", context), "`and` needs both sides.");
+  expect(passes("not alarm_raised", context), "`not` should invert.");
+  expect(passes("has_key || has_lockpick && alarm_raised", context),
+         "`and` should bind tighter than `or`.");
+  expect(!passes("(has_key || has_lockpick) && alarm_raised", context),
+         "Parentheses should group.");
+  expect(passes("NOT (has_lockpick AND has_key)", context), "Keywords should ignore case.");
+  expect(passes("!!has_key", context), "`!` should stack.");
+}
+
+void test_value_comparisons() {
+  adventure::context::GameContext context;
+  context.set_memory_value("zone", "north hall");
+  context.set_memory_value("mood", "calm");
+
+  expect(passes("zone == \"north hall\"", context), "Quoted values may hold spaces.");
+  expect(passes("mood == calm and mood != angry", context), "== and != compare values.");
+  expect(!passes("weather == calm", context), "An unset key equals nothing.");
+  expect(passes("weather != calm", context), "An unset key differs from every value.");
+  expect(passes("has(mood) and not has(weather)", context), "has() tests that a key is set.");
+
+  context.erase_memory_value("mood");
+  expect(!passes("has(mood)", context), "Erased values should no longer be set.");
+  context.clear_memory_flag("never_set");
+  expect(!passes("never_set", context), "Clearing an unknown flag should be harmless.");
+}
+
+void test_number_comparisons() {
+  adventure::context::GameContext context;
+  context.set_memory_number("gold", 10);
+
+  expect(passes("gold >= 10 and gold <= 10 and not (gold < 10) and not (gold > 10)", context),
+         "Ordering operators should compare the stored number.");
+  expect(passes("gold == 10 and gold != 9", context), "Unquoted numbers compare numerically.");
+  expect(!passes("gold == \"10\"", context), "A quoted number compares text.");
+  expect(passes("has(gold) and debt < 1 and not has(debt)", context),
+         "An unset key should read as 0 but not count as set.");
+
+  context.add_memory_number("gold", -15);
+  expect(passes("gold == -5", context), "add_memory_number should go below zero.");
+  context.add_memory_number("gold", INT64_MIN);
+  expect(passes("gold == -9223372036854775808", context), "Adding should saturate.");
+
+  context.set_memory_value("gold", "plenty");
+  expect(!passes("gold >= 0", context) && !passes("gold < 0", context),
+         "Text never compares as a number.");
+  expect(context.get_memory_number("gold") == nullptr, "Text should replace the number.");
+  context.add_memory_number("gold", 3);
+  expect(passes("gold == 3", context) && context.get_memory_value("gold") == nullptr,
+         "Adding to text should start from 0 and replace it.");
+}
+
+void test_syntax_errors_are_reported() {
+  expect(compile_error("(has_key or lockpick").find("`)`") != std::string::npos,
+         "A missing `)` should be named.");
+  expect(compile_error("zone ==").find("value") != std::string::npos,
+         "A comparison without a value should be rejected.");
+  expect(compile_error("zone == \"north").find("Unterminated") != std::string::npos,
+         "An unterminated quote should be rejected.");
+  expect(compile_error("has_key has_lockpick").find("has_lockpick") != std::string::npos,
+         "Trailing tokens should be rejected.");
+  expect(compile_error("has_key and").find("end of condition") != std::string::npos,
+         "A dangling operator should be rejected.");
+  expect(compile_error(std::string(70, '(') + "x" + std::string(70, ')')).find("deeply") !=
+             std::string::npos,
+         "Nesting beyond the evaluation stack should be rejected.");
+  expect(compile_error("zone = 3").find("=") != std::string::npos,
+         "Unknown operators should be rejected.");
+  expect(compile_error("gold >= ten").find("whole number") != std::string::npos,
+         "Ordering comparisons should need a whole number.");
+}
+
+void test_guard_combines_tokens_and_expressions() {
+  std::vector<adventure::parser::OptionCondition> conditions(2);
+  conditions[0].option_id = "door";
+  conditions[0].required_flags = {"awake"};
+  conditions[0].expression = "has_key or has_lockpick";
+  conditions[1].option_id = "window";
+  conditions[1].forbidden_flags = {"awake"};
+  conditions[1].number_bounds = {{"gold", 5, false}, {"gold", 9, true}};
+  conditions[1].required_values = {{"torch", "1"}};
+
+  adventure::conditions::ConditionProgram guard;
+  std::string error;
+  expect(adventure::conditions::compile_guard(conditions, "door", &guard, &error),
+         "The door guard should compile.");
+
+  adventure::context::GameContext context;
+  context.set_memory_flag("has_lockpick");
+  expect(!guard.evaluate(context), "Tokens and the expression are ANDed.");
+  context.set_memory_flag("awake");
+  expect(guard.evaluate(context), "The guard should pass once every part holds.");
+
+  adventure::conditions::ConditionProgram window;
+  expect(adventure::conditions::compile_guard(conditions, "window", &window, &error),
+         "The window guard should compile.");
+  context.clear_memory_flag("awake");
+  context.set_memory_number("gold", 7);
+  context.set_memory_number("torch", 1);
+  expect(window.evaluate(context), "Bounds and numeric requires_value should pass.");
+  context.set_memory_number("gold", 10);
+  expect(!window.evaluate(context), "requires_at_most should cap the number.");
+  context.set_memory_number("gold", 4);
+  expect(!window.evaluate(context), "requires_at_least should floor the number.");
+  context.set_memory_flag("awake");
+
+  adventure::conditions::ConditionProgram unguarded;
+  expect(adventure::conditions::compile_guard(conditions, "stairs", &unguarded, &error) &&
+             unguarded.empty() && unguarded.evaluate(context),
+         "An id without conditions always passes.");
+
+  conditions[1].expression = "awake and (";
+  expect(!adventure::conditions::compile_guard(conditions, "window", &unguarded, &error) &&
+             error.find("`window`") != std::string::npos,
+         "Guard errors should name the option.");
+}
+
+}  // namespace
+
+int main() {
+  test_boolean_operators_and_precedence();
+  test_value_comparisons();
+  test_number_comparisons();
+  test_syntax_errors_are_reported();
+  test_guard_combines_tokens_and_expressions();
+  return 0;
+}
@@ -55,5 +55,20 @@ int main() {
   expect(!context.has_memory_flag("door.opened"), "Memory flag should be erasable.");
   expect(!context.has_next_level_request(), "Next-level request should be cleared.");
 
+  context.set_memory_number("player.gold", 10);
+  context.add_memory_number("player.gold", -4);
+  expect(context.get_memory_number("player.gold") != nullptr &&
+             *context.get_memory_number("player.gold") == 6,
+         "Numbers should be stored and adjusted without text.");
+  expect(context.has_memory_value("player.gold"), "A number should count as a set value.");
+  expect(context.get_memory_value("player.gold") == nullptr, "A number should have no text.");
+  context.set_memory_value("player.gold", "none");
+  expect(context.get_memory_number("player.gold") == nullptr,
+         "Setting text should replace the number.");
+  context.add_memory_number("player.gold", 1);
+  context.erase_memory_value("player.gold");
+  expect(!context.has_memory_value("player.gold") && context.memory_numbers().empty(),
+         "Erasing should remove a number too.");
+
   return 0;
 }
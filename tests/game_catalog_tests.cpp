@@ -0,0 +1,92 @@
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "catalog/game_catalog.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+// Freshly written directories count as unstable; age everything so the catalog trusts mtimes.
+void age_tree(const std::filesystem::path& root) {
+  const auto old = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(root)) {
+    std::filesystem::last_write_time(entry.path(), old);
+  }
+  std::filesystem::last_write_time(root, old);
+}
+
+void make_game(const std::filesystem::path& root, const std::string& header) {
+  std::filesystem::create_directories(root / "rooms");
+  write_text_file(root / "start.level",
+                  "[HEADER]\n" + header + "\n[OPTIONS]\nGo -> ./rooms/a.level\n");
+  write_text_file(root / "rooms" / "a.level",
+                  "[DIRECTIVES]\ninput_mode: endgame\nresult: victory\n");
+}
+
+void test_catalog_reads_headers_and_persists_index() {
+  const std::filesystem::path base =
+      std::filesystem::temp_directory_path() / "cli_adventure_game_catalog_tests";
+  std::filesystem::remove_all(base);
+  const std::filesystem::path games = base / "games";
+  const std::filesystem::path index = base / "cache" / "catalog.index";
+  make_game(games / "beta", "title: Beta Quest\nauthor: Ada");
+  make_game(games / "alpha", "id: start");
+  std::filesystem::create_directories(games / "not_a_game");
+  age_tree(games);
+
+  adventure::catalog::GameCatalog catalog(games, index);
+  expect(catalog.refresh(), "First refresh should discover the games.");
+  expect(catalog.games().size() == 2, "Only folders with start.level are games.");
+  expect(catalog.games()[0].title == "alpha", "Title should fall back to the folder name.");
+  expect(catalog.games()[1].title == "Beta Quest" && catalog.games()[1].author == "Ada",
+         "Title and author should come from the start level header.");
+  expect(catalog.games()[1].level_count == 2, "Level count should include nested levels.");
+  expect(!catalog.refresh(), "Nothing changed, so a second refresh should be a no-op.");
+
+  adventure::catalog::GameCatalog reopened(games, index);
+  expect(reopened.games().size() == 2, "A new catalog should start from the saved index.");
+  expect(!reopened.refresh(), "The saved index should still be fresh.");
+
+  // A nested change only moves the mtime of the directory it happened in.
+  write_text_file(games / "beta" / "rooms" / "b.level", "[OPTIONS]\nBack -> ../start.level\n");
+  expect(reopened.refresh(), "A level added in a subdirectory should be noticed.");
+  expect(reopened.games()[1].level_count == 3, "Level count should be updated.");
+
+  write_text_file(games / "alpha" / "start.level",
+                  "[HEADER]\ntitle: Alpha\n[OPTIONS]\nGo -> ./x\n");
+  expect(reopened.refresh() && reopened.games()[0].title == "Alpha",
+         "Editing start.level should update the title.");
+
+  make_game(games / "gamma", "title: Gamma");
+  std::filesystem::remove_all(games / "alpha");
+  expect(reopened.refresh(), "Adding and removing game folders should be noticed.");
+  expect(reopened.games().size() == 2 && reopened.games()[0].title == "Beta Quest" &&
+             reopened.games()[1].title == "Gamma",
+         "The catalog should list beta and gamma, sorted by folder name.");
+}
+
+}  // namespace
+
+int main() {
+  test_catalog_reads_headers_and_persists_index();
+  return 0;
+}
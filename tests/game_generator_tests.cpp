@@ -0,0 +1,95 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "generator/game_generator.h"
+#include "validation/game_validator.h"
+#include "validation/state_explorer.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+std::string read_file(const std::filesystem::path& path) {
+  std::ifstream in(path);
+  std::ostringstream buffer;
+  buffer << in.rdbuf();
+  return buffer.str();
+}
+
+std::filesystem::path fresh_dir(const std::string& name) {
+  const std::filesystem::path root = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(root);
+  return root;
+}
+
+void test_generated_game_validates_cleanly() {
+  adventure::generator::GeneratorOptions options;
+  options.seed = 42;
+  options.level_count = 400;
+  options.rule_density = 0.5;
+  const std::filesystem::path root = fresh_dir("cli_adventure_generator_tests_valid");
+  const adventure::generator::GeneratorStats stats =
+      adventure::generator::generate_game(root, options);
+  expect(stats.files_written == 400 + 2 + options.art_files,
+         "Generator should write every level, both endings and the art files.");
+
+  const adventure::validation::ValidationReport report =
+      adventure::validation::validate_game(root);
+  for (const auto& issue : report.issues) {
+    std::cerr << issue.file << ": " << issue.message << "\n";
+  }
+  expect(report.checked_files == 402 && report.issues.empty(),
+         "A generated game should have no validation issues.");
+  expect(adventure::validation::explore_game(root).victory_reachable,
+         "Victory should be reachable in the generated game.");
+}
+
+void test_same_seed_gives_identical_output() {
+  adventure::generator::GeneratorOptions options;
+  options.seed = 9;
+  options.level_count = 60;
+  options.directory_depth = 0;
+  options.branching = 1;
+  options.art_files = 0;
+  const std::filesystem::path first = fresh_dir("cli_adventure_generator_tests_a");
+  const std::filesystem::path second = fresh_dir("cli_adventure_generator_tests_b");
+  adventure::generator::generate_game(first, options);
+  adventure::generator::generate_game(second, options);
+
+  std::size_t compared = 0;
+  for (const auto& entry : std::filesystem::recursive_directory_iterator(first)) {
+    if (!entry.is_regular_file()) {
+      continue;
+    }
+    const std::filesystem::path relative = entry.path().lexically_relative(first);
+    expect(read_file(entry.path()) == read_file(second / relative),
+           "File differs between runs: " + relative.string());
+    ++compared;
+  }
+  expect(compared == 61, "Flat single-branch game should have 60 levels plus the win ending.");
+  expect(adventure::validation::validate_game(first).issues.empty(),
+         "Depth 0 / branching 1 games should validate cleanly too.");
+
+  options.seed = 10;
+  const std::filesystem::path third = fresh_dir("cli_adventure_generator_tests_c");
+  adventure::generator::generate_game(third, options);
+  expect(read_file(first / "start.level") != read_file(third / "start.level"),
+         "A different seed should produce different content.");
+}
+
+}  // namespace
+
+int main() {
+  test_generated_game_validates_cleanly();
+  test_same_seed_gives_identical_output();
+  return 0;
+}
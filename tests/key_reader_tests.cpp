@@ -0,0 +1,85 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "ui/key_reader.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+std::vector<adventure::ui::KeyEvent> decode_all(const std::string& bytes) {
+  adventure::ui::KeyDecoder decoder;
+  std::vector<adventure::ui::KeyEvent> events;
+  for (char byte : bytes) {
+    adventure::ui::KeyEvent event;
+    if (decoder.feed(static_cast<unsigned char>(byte), &event)) {
+      events.push_back(event);
+    }
+  }
+  if (decoder.pending()) {
+    events.push_back(decoder.flush());
+  }
+  return events;
+}
+
+void test_decodes_csi_and_ss3_sequences() {
+  using adventure::ui::KeyCode;
+  const std::vector<adventure::ui::KeyEvent> events =
+      decode_all("\x1b[A\x1bOB\x1b[5~\x1b[6~\x1b[1~\x1b[4~\x1b[1;5C\x1b[H\x1bOF");
+
+  const std::vector<KeyCode> expected = {KeyCode::kUp,     KeyCode::kDown,     KeyCode::kPageUp,
+                                         KeyCode::kPageDown, KeyCode::kHome, KeyCode::kEnd,
+                                         KeyCode::kRight,  KeyCode::kHome,     KeyCode::kEnd};
+  expect(events.size() == expected.size(), "Every sequence should decode to exactly one key.");
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    expect(events[i].code == expected[i], "Decoded key mismatch at index " + std::to_string(i));
+  }
+}
+
+void test_decodes_pasted_text_and_lone_escape() {
+  using adventure::ui::KeyCode;
+  const std::vector<adventure::ui::KeyEvent> events = decode_all("ab\r\x1b");
+  expect(events.size() == 4, "Pasted text should decode byte by byte.");
+  expect(events[0].code == KeyCode::kChar && events[0].ch == 'a', "First pasted char mismatch.");
+  expect(events[1].code == KeyCode::kChar && events[1].ch == 'b', "Second pasted char mismatch.");
+  expect(events[2].code == KeyCode::kEnter, "Carriage return should decode to Enter.");
+  expect(events[3].code == KeyCode::kEscape, "Trailing ESC should flush to Escape.");
+}
+
+void test_reader_times_out_on_incomplete_sequence() {
+  int fds[2];
+  expect(pipe(fds) == 0, "pipe() failed.");
+
+  const std::string bytes = "\x1b[B\x1b[B\x1b";
+  expect(write(fds[1], bytes.data(), bytes.size()) == static_cast<ssize_t>(bytes.size()),
+         "write() failed.");
+
+  adventure::ui::KeyReader reader(fds[0], 10);
+  expect(reader.next().code == adventure::ui::KeyCode::kDown, "First buffered arrow mismatch.");
+  expect(reader.has_buffered_input(), "Remaining bytes should stay buffered after one read.");
+  expect(reader.next().code == adventure::ui::KeyCode::kDown, "Second buffered arrow mismatch.");
+  expect(reader.next().code == adventure::ui::KeyCode::kEscape,
+         "Lone ESC should resolve to Escape after the inter-byte timeout.");
+
+  close(fds[1]);
+  expect(reader.next().code == adventure::ui::KeyCode::kEof, "Closed input should report EOF.");
+  close(fds[0]);
+}
+
+}  // namespace
+
+int main() {
+  test_decodes_csi_and_ss3_sequences();
+  test_decodes_pasted_text_and_lone_escape();
+  test_reader_times_out_on_incomplete_sequence();
+  return 0;
+}
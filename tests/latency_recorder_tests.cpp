@@ -0,0 +1,115 @@
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+#include "ui/latency_recorder.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+bool within_percent(std::uint64_t actual, std::uint64_t expected, double percent) {
+  const double delta = static_cast<double>(actual) - static_cast<double>(expected);
+  return (delta < 0 ? -delta : delta) <= static_cast<double>(expected) * percent / 100.0;
+}
+
+std::string read_all(const std::filesystem::path& path) {
+  std::ifstream in(path);
+  return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void test_histogram_percentiles_stay_within_bucket_error() {
+  adventure::ui::LatencyHistogram histogram;
+  expect(histogram.percentile(0.5) == 0, "Empty histogram should report zero.");
+
+  // 1us .. 1000us in 1us steps.
+  for (std::uint64_t us = 1; us <= 1000; ++us) {
+    histogram.record(us * 1000);
+  }
+  expect(histogram.count() == 1000, "Histogram should count every sample.");
+  expect(histogram.max() == 1000000, "Histogram should keep the exact maximum.");
+  expect(within_percent(histogram.percentile(0.50), 500000, 7.0), "p50 outside bucket error.");
+  expect(within_percent(histogram.percentile(0.99), 990000, 7.0), "p99 outside bucket error.");
+  expect(histogram.percentile(1.0) == 1000000, "p100 should be clamped to the maximum.");
+
+  adventure::ui::LatencyHistogram small;
+  small.record(3);
+  expect(small.percentile(0.5) == 3, "Values below 16ns should be recorded exactly.");
+
+  histogram.clear();
+  expect(histogram.count() == 0 && histogram.max() == 0, "clear() should reset the histogram.");
+}
+
+void test_disabled_recorder_ignores_events() {
+  adventure::ui::LatencyRecorder recorder;
+  recorder.begin_session("quiet");
+  recorder.input_committed();
+  recorder.frame_presented("games/a/start.level");
+  expect(recorder.session_histogram().count() == 0, "Disabled recorder should not record.");
+}
+
+void test_samples_are_attributed_per_level() {
+  const std::filesystem::path log =
+      std::filesystem::temp_directory_path() /
+      ("cli_adventure_latency_" + std::to_string(getpid()) + ".log");
+  std::filesystem::remove(log);
+
+  adventure::ui::LatencyRecorder recorder;
+  recorder.enable(log);
+  recorder.begin_session("demo");
+
+  // A frame without a preceding Enter (e.g. the first scene) is not a sample.
+  recorder.frame_presented("start.level");
+  recorder.input_committed();
+  recorder.frame_presented("cave.level");
+  recorder.input_committed();
+  recorder.input_committed();  // rejected input followed by a retry counts once
+  recorder.frame_presented("cave.level");
+  recorder.input_committed();
+  recorder.frame_presented("end.level");
+  expect(recorder.session_histogram().count() == 3, "Session should hold three samples.");
+
+  std::ostringstream report;
+  recorder.write_report(report);
+  const std::string text = report.str();
+  expect(text.find("session demo n=3") != std::string::npos, "Missing session summary.");
+  expect(text.find("level cave.level n=2") != std::string::npos, "Missing cave.level line.");
+  expect(text.find("level end.level n=1") != std::string::npos, "Missing end.level line.");
+  expect(text.find("start.level") == std::string::npos, "Unprompted frame should not count.");
+  expect(text.find("p999=") != std::string::npos, "Report should include p999.");
+
+  // SIGUSR1 asks for a dump, written at the next recorder event.
+  std::raise(SIGUSR1);
+  expect(read_all(log).empty(), "Dump should not be written from the signal handler.");
+  recorder.input_committed();
+  expect(read_all(log).find("session demo n=3") != std::string::npos,
+         "SIGUSR1 should append a report at the next event.");
+
+  recorder.end_session();
+  const std::string logged = read_all(log);
+  expect(logged.find("session demo") != logged.rfind("session demo"),
+         "end_session should append a second report.");
+  std::filesystem::remove(log);
+}
+
+}  // namespace
+
+int main() {
+  test_histogram_percentiles_stay_within_bucket_error();
+  test_disabled_recorder_ignores_events();
+  test_samples_are_attributed_per_level();
+  return 0;
+}
@@ -0,0 +1,116 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "validation/game_validator.h"
+#include "validation/level_graph.h"
+
+namespace {
+
+using adventure::validation::LevelKind;
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+void test_reports_unreachable_levels_and_trap_cycles() {
+  adventure::validation::LevelGraphBuilder builder;
+  const auto start = builder.add_level("start", LevelKind::kPlayable);
+  const auto loop_a = builder.add_level("loop_a", LevelKind::kPlayable);
+  const auto loop_b = builder.add_level("loop_b", LevelKind::kPlayable);
+  builder.add_level("win", LevelKind::kVictory);
+  const auto orphan = builder.add_level("orphan", LevelKind::kPlayable);
+  builder.add_edge(start, "loop_a");
+  builder.add_edge(start, "win");
+  builder.add_edge(loop_a, "loop_b");
+  builder.add_edge(loop_b, "loop_a");
+  builder.add_edge(orphan, "start");
+  builder.add_edge(start, "missing");
+
+  const adventure::validation::LevelGraph graph = builder.build("start");
+  expect(graph.edge_targets.size() == 5, "Unresolved targets should be dropped from the graph.");
+
+  const adventure::validation::GraphAnalysis analysis =
+      adventure::validation::analyze_level_graph(graph);
+  expect(analysis.unreachable.size() == 1 && analysis.unreachable[0] == orphan,
+         "Only the orphan level should be unreachable.");
+  expect(analysis.trap_cycles.size() == 1 && analysis.trap_cycles[0].size() == 2,
+         "The loop with no exit should be reported as one trap cycle.");
+  expect(analysis.victory_reachable, "Victory endgame should be reachable.");
+}
+
+void test_cycle_with_exit_is_not_a_trap_and_long_chains_do_not_recurse() {
+  adventure::validation::LevelGraphBuilder builder;
+  const std::uint32_t level_count = 200000;
+  for (std::uint32_t i = 0; i < level_count; ++i) {
+    builder.add_level("level_" + std::to_string(i), LevelKind::kPlayable);
+  }
+  builder.add_level("lose", LevelKind::kGameOver);
+  for (std::uint32_t i = 0; i + 1 < level_count; ++i) {
+    builder.add_edge(i, "level_" + std::to_string(i + 1));
+    builder.add_edge(i + 1, "level_" + std::to_string(i));
+  }
+  builder.add_edge(level_count - 1, "lose");
+
+  const adventure::validation::GraphAnalysis analysis =
+      adventure::validation::analyze_level_graph(builder.build("level_0"));
+  expect(analysis.unreachable.empty(), "Every chained level should be reachable.");
+  expect(analysis.trap_cycles.empty(), "A cycle that can reach an endgame is not a trap.");
+  expect(!analysis.victory_reachable, "Game-over endings must not count as victory.");
+}
+
+void test_validator_reports_graph_issues() {
+  const std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "cli_adventure_level_graph_tests";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root);
+
+  write_text_file(root / "start.level", R"([OPTIONS]
+go | Go to the hall -> ./hall.level
+)");
+  write_text_file(root / "hall.level", R"([OPTIONS]
+back | Back to start -> ./start.level
+)");
+  write_text_file(root / "secret.level", R"([DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+
+  const adventure::validation::ValidationReport report =
+      adventure::validation::validate_game(root);
+  bool saw_unreachable = false;
+  bool saw_trap = false;
+  bool saw_no_victory = false;
+  for (const auto& issue : report.issues) {
+    saw_unreachable |= issue.file.filename() == "secret.level" &&
+                       issue.message.find("unreachable") != std::string::npos;
+    saw_trap |= issue.message.find("Trap cycle") != std::string::npos;
+    saw_no_victory |= issue.message.find("No `result: victory`") != std::string::npos;
+  }
+  expect(saw_unreachable, "Validator should report the unreachable victory level.");
+  expect(saw_trap, "Validator should report the start/hall trap cycle.");
+  expect(saw_no_victory, "Validator should report that no victory is reachable.");
+}
+
+}  // namespace
+
+int main() {
+  test_reports_unreachable_levels_and_trap_cycles();
+  test_cycle_with_exit_is_not_a_trap_and_long_chains_do_not_recurse();
+  test_validator_reports_graph_issues();
+  return 0;
+}
@@ -0,0 +1,124 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "cli/batch_commands.h"
+#include "context/game_context.h"
+#include "parser/tag_parser.h"
+#include "validation/memory_footprint.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+adventure::validation::ParsedBytes measure(const std::string& text) {
+  std::istringstream input(text);
+  return adventure::validation::measure_parsed_level(adventure::parser::TagParser().parse(input));
+}
+
+void test_parsed_level_bytes_grow_with_content() {
+  const adventure::validation::ParsedBytes small = measure(R"([CONTENT]
+Hi.
+
+[OPTIONS]
+Go -> ./next.level
+)");
+  const adventure::validation::ParsedBytes large =
+      measure("[CONTENT]\n" + std::string(400, 'a') + "\n" + std::string(400, 'b') + R"(
+
+[OPTIONS]
+Go -> ./next.level
+)");
+
+  expect(small.objects == sizeof(adventure::parser::ParsedLevelData),
+         "Objects should count the ParsedLevelData itself.");
+  expect(small.vectors > 0, "Content and option vectors should be counted.");
+  expect(large.strings >= small.strings + 800, "Long content lines should count as string bytes.");
+  expect(large.vectors >= small.vectors, "More lines should not shrink vector storage.");
+  expect(large.total() == large.objects + large.strings + large.vectors + large.maps,
+         "Total should be the sum of the categories.");
+}
+
+void test_game_footprint_covers_art_symbols_and_context() {
+  const std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "cli_adventure_memory_footprint_tests";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root / "art");
+
+  write_text_file(root / "art" / "gate.txt", std::string(300, '#') + "\n");
+  write_text_file(root / "start.level", R"([HEADER]
+title: Gate
+ascii_art: ./art/gate.txt
+
+[CONTENT]
+A gate.
+
+[OPTIONS]
+open | Open it -> ./win.level
+
+[OPTION_EFFECTS]
+option=open add_flag=gate_opened
+option=open set_value=mood:triumphant_and_somewhat_tired
+)");
+  write_text_file(root / "win.level", R"([HEADER]
+ascii_art: ./art/gate.txt
+
+[CONTENT]
+You win.
+
+[DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+
+  const adventure::validation::MemoryFootprintReport report =
+      adventure::validation::measure_game_footprint(root);
+  expect(report.levels.size() == 2, "Both levels should be measured.");
+  expect(report.levels[0].total() >= report.levels[1].total(), "Levels should be largest first.");
+  expect(report.levels[0].level == "start.level", "The level with effects should be largest.");
+  expect(report.ascii_art == 2 * 301, "Art is copied into each level's scene.");
+  expect(report.ascii_art_files == 1, "Shared art should count as one file.");
+  expect(report.symbol_count == 3, "gate_opened, mood and its value should be interned.");
+  expect(report.context_initial >= sizeof(adventure::context::GameContext),
+         "Context should include the GameContext object.");
+  expect(report.context_peak > report.context_initial + 30,
+         "Peak context should hold the flag and the longest value.");
+  expect(report.total() ==
+             report.parsed.total() + report.ascii_art + report.symbols + report.context_peak,
+         "Total should add up the categories.");
+
+  std::ostringstream json;
+  expect(adventure::cli::run_footprint_command(root, json) == adventure::cli::kExitOk,
+         "Footprint command should succeed.");
+  expect(json.str().find("\"top_levels\": [\n    {\"level\": \"start.level\"") !=
+             std::string::npos,
+         "JSON should list the largest level first.");
+  expect(json.str().find("\"ascii_art\": {\"bytes\": 602, \"files\": 1}") != std::string::npos,
+         "JSON should include the art totals.");
+  std::filesystem::remove_all(root);
+}
+
+}  // namespace
+
+int main() {
+  test_parsed_level_bytes_grow_with_content();
+  test_game_footprint_covers_art_symbols_and_context();
+  return 0;
+}
@@ -0,0 +1,178 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "parser/tag_parser.h"
+#include "validation/game_validator.h"
+#include "validation/memory_lint.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+std::vector<adventure::validation::MemoryAccess> accesses_of(const std::string& text) {
+  std::istringstream input(text);
+  return adventure::validation::collect_memory_accesses(
+      adventure::parser::TagParser().parse(input));
+}
+
+bool has_finding(const std::vector<adventure::validation::MemoryLintFinding>& findings,
+                 std::uint32_t level, const std::string& text) {
+  for (const auto& finding : findings) {
+    if (finding.level == level && finding.message.find(text) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void test_reports_reads_writes_and_compared_values() {
+  adventure::validation::MemoryLint lint;
+  lint.add_level(0, accesses_of(R"([OPTIONS]
+take | Take the key -> ./door.level
+ask | Ask the guard -> ./door.level
+
+[MEMORY]
+on_enter add_flag=visited_cell
+on_enter set_value=mood:calm
+
+[OPTION_EFFECTS]
+option=take add_flag=got_key
+option=ask set_value=guard:asleep
+)"));
+  lint.add_level(1, accesses_of(R"([OPTIONS]
+open | Open the door -> ./out.level
+sneak | Sneak past -> ./out.level
+wait | Wait -> ./out.level
+
+[OPTION_CONDITIONS]
+option=open requires_flag=got_kye
+option=open forbids_flag=got_key
+option=sneak requires_value=guard:asleep
+option=wait requires_value=guard:sleeping
+option=wait requires_missing_value=alarm
+)"));
+
+  const auto findings = lint.findings();
+  expect(findings.size() == 5, "Expected exactly five memory findings.");
+  expect(has_finding(findings, 1, "Flag `got_kye` is checked"),
+         "A misspelled required flag should be reported where it is read.");
+  expect(has_finding(findings, 0, "Flag `visited_cell` is set but"),
+         "A flag nobody reads should be reported where it is set.");
+  expect(has_finding(findings, 0, "Value `mood` is assigned but"),
+         "A value nobody reads should be reported where it is assigned.");
+  expect(has_finding(findings, 1, "Value `alarm` is checked"),
+         "requires_missing_value on a never-assigned key should be reported.");
+  expect(has_finding(findings, 1, "compared against `sleeping`"),
+         "Comparing against a value that is never assigned should be reported.");
+}
+
+void test_condition_expressions_are_reads() {
+  adventure::validation::MemoryLint lint;
+  lint.add_level(0, accesses_of(R"([OPTIONS]
+take | Take the key -> ./door.level
+
+[OPTION_EFFECTS]
+option=take add_flag=got_key set_value=door:ajar
+)"));
+  lint.add_level(1, accesses_of(R"([OPTIONS]
+open | Open the door -> ./out.level
+
+[OPTION_CONDITIONS]
+option=open when got_key or (has(lamp) and door == "wide open")
+)"));
+
+  const auto findings = lint.findings();
+  expect(findings.size() == 2, "Expected two findings from the expression.");
+  expect(has_finding(findings, 1, "Value `lamp`"),
+         "has() on a never-assigned key should be reported.");
+  expect(has_finding(findings, 1, "wide open"),
+         "A compared value that is never assigned should be reported.");
+}
+
+void test_numbers_compare_by_value_and_counters_by_anything() {
+  adventure::validation::MemoryLint lint;
+  lint.add_level(0, accesses_of(R"([MEMORY]
+on_enter set_value=floor:07 set_value=gold:10
+
+[OPTIONS]
+work | Work -> ./shop.level
+
+[OPTION_EFFECTS]
+option=work add_value=gold:3
+)"));
+  lint.add_level(1, accesses_of(R"([OPTIONS]
+buy | Buy -> ./out.level
+up | Climb -> ./out.level
+down | Descend -> ./out.level
+
+[OPTION_CONDITIONS]
+option=buy requires_value=gold:13 requires_at_least=debt:1
+option=up requires_value=floor:7
+option=down when floor == 8
+)"));
+
+  const auto findings = lint.findings();
+  expect(findings.size() == 2, "Expected two findings about numbers.");
+  expect(has_finding(findings, 1, "Value `debt` is checked"),
+         "A bound on a never-assigned key should be reported.");
+  expect(has_finding(findings, 1, "compared against `8`"),
+         "A number no set_value assigns should be reported, but `07` equals `7`.");
+}
+
+void test_validator_runs_lint_on_cached_results() {
+  const std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "cli_adventure_memory_lint_tests";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root);
+
+  write_text_file(root / "start.level", R"([OPTIONS]
+win | Win -> ./win.level
+
+[OPTION_CONDITIONS]
+option=win requires_flag=ready
+)");
+  write_text_file(root / "win.level", R"([DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+
+  for (int run = 0; run < 2; ++run) {
+    const adventure::validation::ValidationReport report =
+        adventure::validation::validate_game(root);
+    bool saw_unset_flag = false;
+    for (const auto& issue : report.issues) {
+      saw_unset_flag |= issue.file.filename() == "start.level" &&
+                        issue.message.find("Flag `ready` is checked") != std::string::npos;
+    }
+    expect(saw_unset_flag, "The never-set flag should be reported on every run.");
+    expect(run == 0 || report.rechecked_files == 0, "Second run should come from the cache.");
+  }
+}
+
+}  // namespace
+
+int main() {
+  test_reports_reads_writes_and_compared_values();
+  test_condition_expressions_are_reads();
+  test_numbers_compare_by_value_and_counters_by_anything();
+  test_validator_runs_lint_on_cached_results();
+  return 0;
+}
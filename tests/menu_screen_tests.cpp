@@ -0,0 +1,128 @@
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ui/menu_filter.h"
+#include "ui/menu_screen.h"
+#include "ui/theme.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+std::vector<std::string> make_options(std::size_t count) {
+  std::vector<std::string> options;
+  for (std::size_t i = 0; i < count; ++i) {
+    options.push_back("Option " + std::to_string(i + 1));
+  }
+  return options;
+}
+
+std::vector<std::size_t> identity_view(std::size_t count) {
+  std::vector<std::size_t> view;
+  for (std::size_t i = 0; i < count; ++i) {
+    view.push_back(i);
+  }
+  return view;
+}
+
+void test_selection_change_cost_is_independent_of_option_count() {
+  const adventure::ui::CompiledTheme theme =
+      adventure::ui::compile_theme(adventure::ui::Theme{}, adventure::ui::ColorDepth::kAnsi16);
+  const std::vector<std::string> small = make_options(3);
+  const std::vector<std::string> large = make_options(20);
+
+  std::ostringstream small_out;
+  const std::vector<std::size_t> small_view = identity_view(small.size());
+  adventure::ui::MenuScreen small_screen(small_out, small, small_view, "Pick:", theme, 100);
+  small_screen.draw(0);
+  small_out.str("");
+  small_screen.select(1);
+
+  std::ostringstream large_out;
+  const std::vector<std::size_t> large_view = identity_view(large.size());
+  adventure::ui::MenuScreen large_screen(large_out, large, large_view, "Pick:", theme, 100);
+  large_screen.draw(0);
+  large_out.str("");
+  large_screen.select(1);
+
+  expect(large_out.str().size() == small_out.str().size() + 4,
+         "Differential redraw should only grow with the cursor distance digits.");
+  expect(large_out.str().find("Option 3") == std::string::npos,
+         "Unaffected rows must not be redrawn.");
+}
+
+void test_large_menu_renders_only_visible_window() {
+  const adventure::ui::CompiledTheme theme =
+      adventure::ui::compile_theme(adventure::ui::Theme{}, adventure::ui::ColorDepth::kAnsi16);
+  const std::vector<std::string> options = make_options(500);
+
+  std::ostringstream out;
+  const std::vector<std::size_t> view = identity_view(options.size());
+  adventure::ui::MenuScreen screen(out, options, view, "Choose a game:", theme, 12);
+  screen.draw(0);
+  expect(screen.page_size() == 9, "Window should fit prompt, status and cursor lines.");
+  expect(screen.rendered_lines() == 11, "Rendered lines should count prompt, window and status.");
+  expect(out.str().find("Option 9\n") != std::string::npos, "Last visible row should render.");
+  expect(out.str().find("Option 10\n") == std::string::npos, "Rows past the window must not render.");
+  expect(out.str().find("[1-9 of 500]") != std::string::npos, "Status line should show range.");
+
+  out.str("");
+  screen.select(250);
+  expect(out.str().find("Option 251") != std::string::npos, "Scrolling should show selection.");
+  expect(out.str().find("[243-251 of 500]") != std::string::npos, "Status should follow scroll.");
+  expect(out.str().find("Option 1\n") == std::string::npos, "Scroll must redraw only the window.");
+
+  out.str("");
+  screen.resize(30);
+  expect(screen.page_size() == 27, "Resize should recompute the window height.");
+  expect(out.str().find("Option 251") != std::string::npos,
+         "Selection should stay visible after resize.");
+}
+
+void test_type_ahead_filter_refines_and_maps_back_to_labels() {
+  const std::vector<std::string> labels = {"Open the Iron Door", "Inspect the Iron Door",
+                                           "Explore the Crypt", "Go back to tunnel"};
+  adventure::ui::MenuFilter filter(labels);
+  expect(filter.matches().size() == 4, "Empty query should match every label.");
+
+  filter.push('I');
+  filter.push('r');
+  expect(filter.matches() == std::vector<std::size_t>({0, 1}),
+         "Case-insensitive query should narrow to matching labels.");
+  filter.push('x');
+  expect(filter.matches().empty(), "Non-matching query should leave no matches.");
+  expect(filter.pop(), "Backspace should remove the last query character.");
+  expect(filter.matches() == std::vector<std::size_t>({0, 1}),
+         "Backspace should restore the previous match set.");
+  filter.clear();
+  expect(filter.query().empty() && filter.matches().size() == 4, "Clear should reset filter.");
+
+  for (char ch : std::string("crypt")) {
+    filter.push(ch);
+  }
+  const adventure::ui::CompiledTheme theme =
+      adventure::ui::compile_theme(adventure::ui::Theme{}, adventure::ui::ColorDepth::kAnsi16);
+  std::ostringstream out;
+  adventure::ui::MenuScreen screen(out, labels, filter.matches(), "Pick:", theme, 24);
+  screen.draw(0);
+  expect(out.str().find("Explore the Crypt") != std::string::npos, "Filtered row should render.");
+  expect(out.str().find("Iron Door") == std::string::npos, "Filtered-out rows must not render.");
+  expect(filter.matches()[0] == 2, "Filtered position should map back to the label index.");
+}
+
+}  // namespace
+
+int main() {
+  test_selection_change_cost_is_independent_of_option_count();
+  test_large_menu_renders_only_visible_window();
+  test_type_ahead_filter_refines_and_maps_back_to_labels();
+  return 0;
+}
@@ -1,8 +1,11 @@
 #include <cstdlib>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
 
+#include "parser/keyword_table.h"
 #include "parser/tag_parser.h"
 
 namespace {
@@ -145,6 +148,141 @@ open_door | open sesame -> ./vault.level
   expect(data.input_rules[0].target == "./vault.level", "Input rule target mismatch.");
 }
 
+enum class Fruit { kApple, kBanana, kCherry };
+
+constexpr auto kFruits = adventure::parser::make_keyword_table<Fruit>({
+    {"apple", Fruit::kApple},
+    {"banana", Fruit::kBanana},
+    {"cherry", Fruit::kCherry},
+});
+static_assert(kFruits.find("BaNaNa") != nullptr && *kFruits.find("BaNaNa") == Fruit::kBanana,
+              "Keyword lookup should be case-insensitive at compile time.");
+static_assert(kFruits.find("banan") == nullptr && kFruits.find("") == nullptr,
+              "Near misses should not match.");
+
+void test_keywords_are_case_insensitive() {
+  const std::string input = R"(
+[directives]
+input_mode: EndGame
+
+[Option_Conditions]
+OPTION=go Requires_Flag=lit forbids_FLAG=wet
+
+[option_effects]
+Option=go ADD_FLAG=moved Set_Value=room:hall
+
+[memory]
+On_Enter clear_flag=lit
+)";
+
+  std::istringstream stream(input);
+  const adventure::parser::ParsedLevelData data = adventure::parser::TagParser().parse(stream);
+
+  expect(adventure::parser::input_mode_of(data) == adventure::parser::InputMode::kEndGame,
+         "input_mode should match regardless of case.");
+  expect(data.option_conditions.size() == 1 && data.option_conditions[0].option_id == "go",
+         "Condition keywords should match regardless of case.");
+  expect(data.option_conditions[0].required_flags.size() == 1 &&
+             data.option_conditions[0].forbidden_flags.size() == 1,
+         "Condition flags should be parsed.");
+  expect(data.option_effects.size() == 1 && data.option_effects[0].mutations.size() == 2,
+         "Effect mutations should match regardless of case.");
+  expect(data.option_effects[0].mutations[1].kind ==
+                 adventure::parser::MemoryMutation::Kind::kSetValue &&
+             data.option_effects[0].mutations[1].value == "hall",
+         "set_value should split key and value.");
+  expect(data.on_enter_memory.size() == 1, "ON_ENTER should match regardless of case.");
+
+  std::istringstream unknown("[DIRECTIVES]\ninput_mode: sideways\n");
+  expect(adventure::parser::input_mode_of(adventure::parser::TagParser().parse(unknown)) ==
+             adventure::parser::InputMode::kChoice,
+         "Unknown input modes should fall back to choice.");
+}
+
+void test_condition_expression_after_when() {
+  std::istringstream input(R"([OPTION_CONDITIONS]
+option=door requires_flag=awake WHEN has_key or (lockpick and zone == "north hall")
+option=window when
+)");
+  const adventure::parser::ParsedLevelData data = adventure::parser::TagParser().parse(input);
+  expect(data.option_conditions.size() == 2, "Both condition lines should parse.");
+  const adventure::parser::OptionCondition& door = data.option_conditions[0];
+  expect(door.option_id == "door" && door.required_flags.size() == 1,
+         "Tokens before `when` should parse as before.");
+  expect(door.expression == "has_key or (lockpick and zone == \"north hall\")",
+         "The rest of the line after `when` should be kept as the expression.");
+  expect(data.option_conditions[1].expression.empty(), "An empty expression stays empty.");
+}
+
+void test_numeric_memory_tokens() {
+  std::istringstream input(R"([MEMORY]
+on_enter set_value=gold:10 set_value=mood:calm
+
+[OPTION_CONDITIONS]
+option=buy requires_at_least=gold:10 requires_at_most=gold:99 requires_at_least=gold:lots
+
+[OPTION_EFFECTS]
+option=buy sub_value=gold:10 add_value=rope:1 add_value=rope:many
+)");
+  const adventure::parser::ParsedLevelData data = adventure::parser::TagParser().parse(input);
+  using Kind = adventure::parser::MemoryMutation::Kind;
+
+  expect(data.on_enter_memory.size() == 2 && data.on_enter_memory[0].kind == Kind::kSetNumber &&
+             data.on_enter_memory[0].number == 10 &&
+             data.on_enter_memory[1].kind == Kind::kSetValue,
+         "set_value should store whole numbers as numbers and anything else as text.");
+
+  expect(data.option_conditions.size() == 1 &&
+             data.option_conditions[0].number_bounds.size() == 2,
+         "Bounds without a whole number should be dropped.");
+  const auto& bounds = data.option_conditions[0].number_bounds;
+  expect(bounds[0].key == "gold" && bounds[0].bound == 10 && !bounds[0].at_most &&
+             bounds[1].bound == 99 && bounds[1].at_most,
+         "requires_at_least and requires_at_most should parse their bound.");
+
+  expect(data.option_effects.size() == 1 && data.option_effects[0].mutations.size() == 2,
+         "add_value without a whole number should be dropped.");
+  const auto& mutations = data.option_effects[0].mutations;
+  expect(mutations[0].kind == Kind::kAddNumber && mutations[0].key == "gold" &&
+             mutations[0].number == -10,
+         "sub_value should add the negated amount.");
+  expect(mutations[1].kind == Kind::kAddNumber && mutations[1].number == 1,
+         "add_value should add its amount.");
+}
+
+void test_long_content_is_streamed_from_the_file() {
+  const std::filesystem::path level =
+      std::filesystem::temp_directory_path() / "cli_adventure_parser_stream.level";
+  const std::string first = "Page one.\n   \nPage two.\n";
+  const std::string second = "Epilogue.\n";
+  const std::string text = "[HEADER]\ntitle: Scroll\n[CONTENT]\n" + first +
+                           "[OPTIONS]\nRead on -> ./next.level\n[CONTENT]\n" + second;
+  {
+    std::ofstream out(level, std::ios::binary);
+    out << text;
+  }
+
+  const adventure::parser::ParsedLevelData copied =
+      adventure::parser::TagParser().parse_file(level);
+  expect(copied.streamed_content.empty(), "Short content should be kept in memory.");
+  expect(copied.content_lines.size() == 4, "Both content sections should be copied.");
+
+  const adventure::parser::ParsedLevelData streamed =
+      adventure::parser::TagParser(16).parse_file(level);
+  std::filesystem::remove(level);
+  const adventure::parser::StreamedContent& content = streamed.streamed_content;
+  expect(streamed.content_lines.empty(), "Streamed content should not be copied.");
+  expect(content.path == level.string(), "Streamed content should remember its file.");
+  expect(content.line_count == 4, "Streamed content should count its lines.");
+  expect(content.ranges.size() == 2, "Each content section should get a byte range.");
+  expect(text.substr(content.ranges[0].offset, content.ranges[0].length) == first,
+         "First range should cover the first section's lines.");
+  expect(text.substr(content.ranges[1].offset, content.ranges[1].length) == second,
+         "Second range should run to the end of the file.");
+  expect(streamed.options.size() == 1 && streamed.header.at("title") == "Scroll",
+         "Other sections should parse as usual.");
+}
+
 }  // namespace
 
 int main() {
@@ -154,5 +292,9 @@ int main() {
   test_option_uses_first_delimiter_position();
   test_option_with_explicit_id();
   test_input_rules_with_id();
+  test_keywords_are_case_insensitive();
+  test_condition_expression_after_when();
+  test_numeric_memory_tokens();
+  test_long_content_is_streamed_from_the_file();
   return 0;
 }
@@ -6,6 +6,7 @@
 #include <string>
 #include <vector>
 
+#include "parser/tag_parser.h"
 #include "ui/renderer.h"
 #include "ui/theme.h"
 
@@ -63,9 +64,119 @@ void test_ascii_art_default_and_line_color_tags_with_indentation() {
          "Colon-form line color tag should be applied.");
 }
 
+void test_cached_scene_reuses_frame_for_same_key() {
+  const std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "cli_adventure_renderer_cache_tests";
+  std::filesystem::create_directories(root);
+
+  const std::filesystem::path art_path = root / "art.txt";
+  write_text_file(art_path, {"[color=bright_red]first art"});
+
+  adventure::ui::Theme theme;
+  theme.use_color = true;
+  adventure::ui::Renderer renderer(theme);
+
+  std::ostringstream first;
+  renderer.render_cached_scene(first, "room.level", "Room", {"line one", "line two"},
+                               root.string(), "./art.txt");
+
+  write_text_file(art_path, {"[color=bright_red]second art"});
+
+  std::ostringstream second;
+  renderer.render_cached_scene(second, "room.level", "Room", {"line one", "line two"},
+                               root.string(), "./art.txt");
+  expect(first.str() == second.str(), "Cached scene should re-emit the stored frame bytes.");
+  expect(second.str().find("first art") != std::string::npos,
+         "Cached frame should not reload art for the same scene key.");
+
+  std::ostringstream uncached;
+  renderer.render_scene(uncached, "Room", {"line one", "line two"}, root.string(), "./art.txt");
+  expect(uncached.str().find("\033[91msecond art\033[0m") != std::string::npos,
+         "Uncached render should compose a fresh frame.");
+}
+
+void test_compiled_theme_resolves_extended_colors_per_depth() {
+  using adventure::ui::ColorDepth;
+
+  expect(adventure::ui::compile_color("#ff0000", true, ColorDepth::kTrueColor).prefix ==
+             "\033[38;2;255;0;0m",
+         "Truecolor depth should emit 24-bit escapes.");
+  expect(adventure::ui::compile_color("#ff0000", true, ColorDepth::kAnsi256).prefix ==
+             "\033[38;5;196m",
+         "RGB colors should quantize to the 256-color cube.");
+  expect(adventure::ui::compile_color("color196", true, ColorDepth::kAnsi16).prefix ==
+             "\033[91m",
+         "256-color indexes should fall back to the nearest basic color.");
+  expect(adventure::ui::compile_color("bright_cyan", false, ColorDepth::kTrueColor).prefix.empty(),
+         "Disabled color should compile to empty escapes.");
+
+  adventure::ui::Theme theme;
+  theme.use_color = true;
+  theme.border_line = "==";
+  const adventure::ui::CompiledTheme compiled =
+      adventure::ui::compile_theme(theme, ColorDepth::kAnsi16);
+  expect(compiled.border_line == "\033[96m==\033[0m", "Border line should be pre-colorized.");
+  expect(compiled.selected_prefix == "\033[92m-> ", "Selected prefix should be pre-colorized.");
+}
+
+void test_theme_file_keys_are_case_insensitive() {
+  const std::filesystem::path theme_file =
+      std::filesystem::temp_directory_path() / "cli_adventure_renderer_tests.theme";
+  {
+    std::ofstream out(theme_file);
+    out << "# comment\nTitle_Color = Bright_Magenta\nBORDER_LINE = ~~~~\nuse_color = yes\n"
+        << "unknown_key = ignored\n";
+  }
+  const adventure::ui::Theme theme =
+      adventure::ui::load_theme_from_file(theme_file, adventure::ui::Theme{});
+  std::filesystem::remove(theme_file);
+
+  expect(theme.title_color == "Bright_Magenta", "Mixed-case theme keys should be recognized.");
+  expect(theme.border_line == "~~~~", "Upper-case theme keys should be recognized.");
+  expect(theme.use_color, "use_color should be parsed as a bool.");
+  expect(adventure::ui::compile_color(theme.title_color, true,
+                                      adventure::ui::ColorDepth::kAnsi16).prefix == "\033[95m",
+         "Basic color names should match regardless of case.");
+}
+
+void test_streamed_content_matches_in_memory_content() {
+  const std::filesystem::path level =
+      std::filesystem::temp_directory_path() / "cli_adventure_renderer_stream.level";
+  std::vector<std::string> lines = {"[HEADER]", "title: Long Road", "", "[CONTENT]"};
+  for (int i = 0; i < 50; ++i) {
+    lines.push_back("Mile " + std::to_string(i) + " of the long road.");
+  }
+  lines.push_back("  ");
+  lines.push_back("[OPTIONS]");
+  lines.push_back("Walk on -> ./next.level");
+  write_text_file(level, lines);
+
+  const adventure::parser::ParsedLevelData copied =
+      adventure::parser::TagParser().parse_file(level);
+  const adventure::parser::ParsedLevelData streamed =
+      adventure::parser::TagParser(256).parse_file(level);
+  expect(!streamed.streamed_content.empty(), "The test level should be streamed.");
+
+  const adventure::ui::Renderer renderer(adventure::ui::Theme{});
+  std::ostringstream expected;
+  renderer.render_cached_scene(expected, "", "Long Road", copied.content_lines, "", "");
+  std::ostringstream actual;
+  renderer.render_cached_scene(actual, "", "Long Road", streamed.content_lines, "", "");
+  std::istringstream no_input;
+  renderer.render_streamed_content(no_input, actual, streamed.streamed_content);
+  std::filesystem::remove(level);
+
+  expect(actual.str() == expected.str(),
+         "Non-interactive output should write streamed content in full, as parsed content.");
+}
+
 }  // namespace
 
 int main() {
   test_ascii_art_default_and_line_color_tags_with_indentation();
+  test_cached_scene_reuses_frame_for_same_key();
+  test_compiled_theme_resolves_extended_colors_per_depth();
+  test_theme_file_keys_are_case_insensitive();
+  test_streamed_content_matches_in_memory_content();
   return 0;
 }
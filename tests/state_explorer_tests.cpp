@@ -0,0 +1,173 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "validation/state_explorer.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+std::filesystem::path make_root(const std::string& name) {
+  const std::filesystem::path root = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root);
+  return root;
+}
+
+void test_finds_shortest_path_through_memory_gate() {
+  const std::filesystem::path root = make_root("cli_adventure_state_explorer_gate_tests");
+  write_text_file(root / "start.level", R"([OPTIONS]
+search | Search the room -> ./stash.level
+open_gate | Open the gate -> ./win.level
+
+[OPTION_CONDITIONS]
+option=open_gate requires_flag=got_key
+)");
+  write_text_file(root / "stash.level", R"([OPTIONS]
+take_key | Take key and return -> ./start.level
+
+[OPTION_EFFECTS]
+option=take_key add_flag=got_key
+)");
+  write_text_file(root / "win.level", R"([DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+
+  adventure::validation::ExplorerOptions options;
+  options.threads = 2;
+  const adventure::validation::ExplorationReport report =
+      adventure::validation::explore_game(root, options);
+  expect(report.victory_reachable, "Victory should be reachable after taking the key.");
+  expect(report.winning_path.size() == 4, "Shortest path is start -> stash -> start -> win.");
+  expect(report.winning_path[0].choice == "search", "First move should be search.");
+  expect(report.winning_path[1].choice == "take_key", "Second move should take the key.");
+  expect(report.winning_path[2].choice == "open_gate", "Third move should open the gate.");
+  expect(report.winning_path[3].level.filename() == "win.level", "Path should end at victory.");
+  expect(report.states_explored >= 3, "Explorer should count distinct states.");
+}
+
+void test_value_gate_that_is_never_set_blocks_victory() {
+  const std::filesystem::path root = make_root("cli_adventure_state_explorer_blocked_tests");
+  write_text_file(root / "start.level", R"([MEMORY]
+on_enter set_value=door:locked
+
+[DIRECTIVES]
+input_mode: input
+
+[INPUT_RULES]
+open | open -> ./win.level
+wait | wait -> ./start.level
+
+[OPTION_CONDITIONS]
+option=open requires_value=door:open
+)");
+  write_text_file(root / "win.level", R"([DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+
+  const adventure::validation::ExplorationReport report =
+      adventure::validation::explore_game(root);
+  expect(!report.victory_reachable, "A gate on a value that is never assigned blocks victory.");
+  expect(!report.truncated, "Small state space should be explored completely.");
+}
+
+void test_expression_gate_is_explored() {
+  const std::filesystem::path root = make_root("cli_adventure_state_explorer_expression_tests");
+  write_text_file(root / "start.level", R"([MEMORY]
+on_enter set_value=alarm:quiet
+
+[OPTIONS]
+pick | Pick up a hairpin -> ./start.level
+door | Open the door -> ./win.level
+loud | Kick the door -> ./lose.level
+
+[OPTION_CONDITIONS]
+option=door when (has_key or has_hairpin) and alarm != loud
+option=loud when not has_hairpin
+
+[OPTION_EFFECTS]
+option=pick add_flag=has_hairpin
+)");
+  write_text_file(root / "win.level", "[DIRECTIVES]\ninput_mode: endgame\nresult: victory\n");
+  write_text_file(root / "lose.level", "[DIRECTIVES]\ninput_mode: endgame\nresult: game_over\n");
+
+  const adventure::validation::ExplorationReport report =
+      adventure::validation::explore_game(root, adventure::validation::ExplorerOptions{});
+  expect(report.victory_reachable, "The `or` branch should open the door.");
+  expect(report.winning_path.size() == 3 && report.winning_path[0].choice == "pick" &&
+             report.winning_path[1].choice == "door",
+         "Shortest path should pick the hairpin, then open the door.");
+}
+
+void test_counter_gate_is_explored() {
+  const std::filesystem::path root = make_root("cli_adventure_state_explorer_counter_tests");
+  write_text_file(root / "start.level", R"([OPTIONS]
+work | Work a shift -> ./start.level
+buy | Buy the rope -> ./win.level
+
+[OPTION_CONDITIONS]
+option=work requires_at_most=gold:20
+option=buy when gold >= 15
+
+[OPTION_EFFECTS]
+option=work add_value=gold:4
+option=buy sub_value=gold:15
+)");
+  write_text_file(root / "win.level", "[DIRECTIVES]\ninput_mode: endgame\nresult: victory\n");
+
+  const adventure::validation::ExplorationReport report =
+      adventure::validation::explore_game(root, adventure::validation::ExplorerOptions{});
+  expect(report.victory_reachable, "Working should earn enough gold for the rope.");
+  expect(report.winning_path.size() == 6 && report.winning_path[3].choice == "work" &&
+             report.winning_path[4].choice == "buy",
+         "Four shifts should come before buying.");
+  expect(!report.truncated, "A capped counter should be explored completely.");
+}
+
+void test_state_limit_truncates_search() {
+  const std::filesystem::path root = make_root("cli_adventure_state_explorer_limit_tests");
+  std::string start = "[OPTIONS]\n";
+  std::string effects = "[OPTION_EFFECTS]\n";
+  for (int i = 0; i < 16; ++i) {
+    start += "flag_" + std::to_string(i) + " | Flag " + std::to_string(i) + " -> ./start.level\n";
+    effects += "option=flag_" + std::to_string(i) + " add_flag=f" + std::to_string(i) + "\n";
+  }
+  write_text_file(root / "start.level", start + "\n" + effects);
+
+  adventure::validation::ExplorerOptions options;
+  options.max_states = 1000;
+  const adventure::validation::ExplorationReport report =
+      adventure::validation::explore_game(root, options);
+  expect(report.truncated, "2^16 flag combinations should exceed the state limit.");
+  expect(report.states_explored == 1000, "Explored count should stop at the limit.");
+}
+
+}  // namespace
+
+int main() {
+  test_finds_shortest_path_through_memory_gate();
+  test_value_gate_that_is_never_set_blocks_victory();
+  test_expression_gate_is_explored();
+  test_counter_gate_is_explored();
+  test_state_limit_truncates_search();
+  return 0;
+}
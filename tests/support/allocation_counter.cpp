@@ -0,0 +1,119 @@
+#include "support/allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace adventure::test_support {
+namespace {
+
+std::atomic<int> g_active_scopes{0};
+std::atomic<std::size_t> g_allocations{0};
+std::atomic<std::size_t> g_deallocations{0};
+std::atomic<std::size_t> g_bytes{0};
+
+AllocationCounts snapshot() {
+  AllocationCounts counts;
+  counts.allocations = g_allocations.load(std::memory_order_relaxed);
+  counts.deallocations = g_deallocations.load(std::memory_order_relaxed);
+  counts.bytes = g_bytes.load(std::memory_order_relaxed);
+  return counts;
+}
+
+}  // namespace
+
+void record_allocation(std::size_t size) {
+  if (g_active_scopes.load(std::memory_order_relaxed) > 0) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+  }
+}
+
+void record_deallocation() {
+  if (g_active_scopes.load(std::memory_order_relaxed) > 0) {
+    g_deallocations.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+AllocationScope::AllocationScope() : start_(snapshot()) {
+  g_active_scopes.fetch_add(1, std::memory_order_relaxed);
+}
+
+AllocationScope::~AllocationScope() { g_active_scopes.fetch_sub(1, std::memory_order_relaxed); }
+
+AllocationCounts AllocationScope::counts() const {
+  const AllocationCounts now = snapshot();
+  return AllocationCounts{now.allocations - start_.allocations,
+                          now.deallocations - start_.deallocations, now.bytes - start_.bytes};
+}
+
+}  // namespace adventure::test_support
+
+namespace {
+
+void* counted_allocate(std::size_t size) {
+  adventure::test_support::record_allocation(size);
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* counted_allocate_aligned(std::size_t size, std::align_val_t alignment) {
+  adventure::test_support::record_allocation(size);
+  const std::size_t align = static_cast<std::size_t>(alignment);
+  const std::size_t rounded = ((size == 0 ? 1 : size) + align - 1) / align * align;
+  void* pointer = std::aligned_alloc(align, rounded);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void counted_free(void* pointer) {
+  if (pointer != nullptr) {
+    adventure::test_support::record_deallocation();
+    std::free(pointer);
+  }
+}
+
+}  // namespace
+
+void* operator new(std::size_t size) { return counted_allocate(size); }
+void* operator new[](std::size_t size) { return counted_allocate(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return counted_allocate(size);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  try {
+    return counted_allocate(size);
+  } catch (const std::bad_alloc&) {
+    return nullptr;
+  }
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return counted_allocate_aligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return counted_allocate_aligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { counted_free(pointer); }
+void operator delete[](void* pointer) noexcept { counted_free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { counted_free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { counted_free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { counted_free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { counted_free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { counted_free(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { counted_free(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept {
+  counted_free(pointer);
+}
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept {
+  counted_free(pointer);
+}
@@ -0,0 +1,34 @@
+#ifndef CLI_ADVENTURE_TESTS_SUPPORT_ALLOCATION_COUNTER_H_
+#define CLI_ADVENTURE_TESTS_SUPPORT_ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+namespace adventure::test_support {
+
+struct AllocationCounts {
+  std::size_t allocations = 0;
+  std::size_t deallocations = 0;
+  std::size_t bytes = 0;
+};
+
+// Counts global operator new/delete calls made while at least one scope is alive. Linking the
+// test support library replaces the global allocation functions for the whole test binary;
+// outside a scope they only forward to malloc/free.
+class AllocationScope {
+ public:
+  AllocationScope();
+  ~AllocationScope();
+
+  AllocationScope(const AllocationScope&) = delete;
+  AllocationScope& operator=(const AllocationScope&) = delete;
+
+  // Counts since this scope was opened (including those of nested scopes).
+  AllocationCounts counts() const;
+
+ private:
+  AllocationCounts start_;
+};
+
+}  // namespace adventure::test_support
+
+#endif  // CLI_ADVENTURE_TESTS_SUPPORT_ALLOCATION_COUNTER_H_
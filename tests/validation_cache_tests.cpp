@@ -0,0 +1,163 @@
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "validation/game_validator.h"
+#include "validation/validation_cache.h"
+
+namespace {
+
+void expect(bool condition, const std::string& message) {
+  if (!condition) {
+    std::cerr << "FAILED: " << message << "\n";
+    std::exit(1);
+  }
+}
+
+void write_text_file(const std::filesystem::path& path, const std::string& content) {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    std::cerr << "FAILED: cannot write " << path << "\n";
+    std::exit(1);
+  }
+  out << content;
+}
+
+bool has_issue(const adventure::validation::ValidationReport& report, const std::string& file,
+               const std::string& text) {
+  for (const auto& issue : report.issues) {
+    if (issue.file.filename() == file && issue.message.find(text) != std::string::npos) {
+      return true;
+    }
+  }
+  return false;
+}
+
+std::filesystem::path make_game() {
+  const std::filesystem::path root =
+      std::filesystem::temp_directory_path() / "cli_adventure_validation_cache_tests";
+  std::filesystem::remove_all(root);
+  std::filesystem::create_directories(root / "endings");
+
+  write_text_file(root / "start.level", R"([OPTIONS]
+hall | Go to the hall -> ./hall.level
+win | Escape -> ./endings/win.level
+)");
+  write_text_file(root / "hall.level", R"([OPTIONS]
+back | Back to start -> ./start.level
+vault | Open the vault -> ./vault.level
+)");
+  write_text_file(root / "endings" / "win.level", R"([DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+  return root;
+}
+
+void test_second_run_is_answered_from_cache() {
+  const std::filesystem::path root = make_game();
+
+  const adventure::validation::ValidationReport first = adventure::validation::validate_game(root);
+  expect(first.checked_files == 3 && first.rechecked_files == 3,
+         "First validation should check every file.");
+  expect(std::filesystem::exists(root / adventure::validation::kValidationCacheFileName),
+         "Validation should write a cache file into the game root.");
+  expect(has_issue(first, "hall.level", "Missing option target `./vault.level`"),
+         "Missing vault target should be reported.");
+
+  const adventure::validation::ValidationReport second = adventure::validation::validate_game(root);
+  expect(second.checked_files == 3 && second.rechecked_files == 0,
+         "Unchanged files should be answered from the cache.");
+  expect(second.issues.size() == first.issues.size() &&
+             has_issue(second, "hall.level", "Missing option target `./vault.level`"),
+         "Cached results should report the same issues.");
+}
+
+void test_edits_and_target_changes_invalidate_only_affected_files() {
+  const std::filesystem::path root = make_game();
+  adventure::validation::validate_game(root);
+
+  // Creating a referenced target re-checks the level pointing at it, plus the new file.
+  write_text_file(root / "vault.level", R"([DIRECTIVES]
+input_mode: endgame
+result: game_over
+)");
+  const adventure::validation::ValidationReport added = adventure::validation::validate_game(root);
+  expect(added.checked_files == 4 && added.rechecked_files == 2,
+         "Only hall.level and the new vault.level should be re-checked.");
+  expect(!has_issue(added, "hall.level", "Missing option target"),
+         "The vault target now exists.");
+
+  // Editing content re-checks just that file.
+  write_text_file(root / "start.level", R"([OPTIONS]
+hall | Go to the hall -> ./hall.level
+)");
+  const adventure::validation::ValidationReport edited = adventure::validation::validate_game(root);
+  expect(edited.rechecked_files == 1, "Only the edited start.level should be re-checked.");
+  expect(has_issue(edited, "win.level", "unreachable"),
+         "Graph analysis should still run over cached per-file results.");
+
+  // Removing a target invalidates its referrers again.
+  std::filesystem::remove(root / "vault.level");
+  const adventure::validation::ValidationReport removed =
+      adventure::validation::validate_game(root);
+  expect(removed.checked_files == 3 && removed.rechecked_files == 1,
+         "Removing vault.level should re-check hall.level only.");
+  expect(has_issue(removed, "hall.level", "Missing option target `./vault.level`"),
+         "The removed target should be reported as missing again.");
+}
+
+void test_damaged_cache_falls_back_to_full_validation() {
+  const std::filesystem::path root = make_game();
+  adventure::validation::validate_game(root);
+  write_text_file(root / adventure::validation::kValidationCacheFileName, "garbage\n");
+
+  const adventure::validation::ValidationReport report = adventure::validation::validate_game(root);
+  expect(report.rechecked_files == 3, "An unreadable cache should trigger a full validation.");
+  expect(adventure::validation::validate_game(root).rechecked_files == 0,
+         "The rewritten cache should be used on the next run.");
+}
+
+void test_targets_resolve_inside_and_outside_the_game_root() {
+  const std::filesystem::path base =
+      std::filesystem::temp_directory_path() / "cli_adventure_validation_file_index_tests";
+  std::filesystem::remove_all(base);
+  std::filesystem::create_directories(base / "game" / "rooms");
+  std::filesystem::create_directories(base / "shared");
+
+  write_text_file(base / "game" / "start.level", R"([OPTIONS]
+room | Enter -> ./rooms/../rooms/room.level
+shared | Leave -> ../shared/exit.level
+gone | Vanish -> ./rooms/missing.level
+)");
+  write_text_file(base / "game" / "rooms" / "room.level", R"([OPTIONS]
+back | Back -> ../start.level
+)");
+  write_text_file(base / "shared" / "exit.level", R"([DIRECTIVES]
+input_mode: endgame
+result: victory
+)");
+
+  const adventure::validation::ValidationReport report =
+      adventure::validation::validate_game(base / "game/");
+  expect(!has_issue(report, "start.level", "`./rooms/../rooms/room.level`"),
+         "Non-normalized targets inside the root should be found in the file index.");
+  expect(!has_issue(report, "start.level", "`../shared/exit.level`"),
+         "Targets outside the game root should still be checked on disk.");
+  expect(has_issue(report, "start.level", "`./rooms/missing.level`"),
+         "Missing targets inside the root should be reported.");
+  expect(!has_issue(report, "start.level", "must contain start.level"),
+         "start.level should be found through the file index.");
+}
+
+}  // namespace
+
+int main() {
+  test_second_run_is_answered_from_cache();
+  test_edits_and_target_changes_invalidate_only_affected_files();
+  test_damaged_cache_falls_back_to_full_validation();
+  test_targets_resolve_inside_and_outside_the_game_root();
+  return 0;
+}